@@ -64,6 +64,8 @@ void FEMTree< Dim , Real >::_Evaluator< UIntPack< FEMSigs ... > , PointD >::set(
 	static const unsigned int LeftCornerRadii[] = { BSplineSupportSizes< FEMSignature< FEMSigs >::Degree >::SupportEnd ... };
 	typedef UIntPack< ( BSplineSupportSizes< FEMSignature< FEMSigs >::Degree >::BCornerSize + 1 ) ... > BCornerSizes;
 	static const unsigned int LeftBCornerRadii[] = { BSplineSupportSizes< FEMSignature< FEMSigs >::Degree >::BCornerEnd ... };
+	static const CornerLoopData< BSplineSupportSizes< FEMSignature< FEMSigs >::Degree >::SupportSize ... > cornerLoopData;
+	static const CornerLoopData< ( BSplineSupportSizes< FEMSignature< FEMSigs >::Degree >::BCornerSize + 1 ) ... > bCornerLoopData;
 
 	if( stencilData ) DeletePointer( stencilData );
 	stencilData = NewPointer< StencilData >( maxDepth+1 );
@@ -141,6 +143,18 @@ void FEMTree< Dim , Real >::_Evaluator< UIntPack< FEMSigs ... > , PointD >::set(
 					stencilData[depth].pcBCornerStencils[c][cc]()
 				);
 		}
+
+		// Record the entries of the corner stencils that are non-zero so that evaluation can skip the rest
+		for( int c=0 ; c<(1<<Dim) ; c++ )
+		{
+			_SetSupport( stencilData[depth].ccCornerSupport[c] , stencilData[depth].ccCornerStencil[c] , cornerLoopData.ccSize[c] , cornerLoopData.ccIndices[c] );
+			_SetSupport( stencilData[depth].ccBCornerSupport[c] , stencilData[depth].ccBCornerStencil[c] , bCornerLoopData.ccSize[c] , bCornerLoopData.ccIndices[c] );
+			for( int _c=0 ; _c<(1<<Dim) ; _c++ )
+			{
+				_SetSupport( stencilData[depth].pcCornerSupports[_c][c] , stencilData[depth].pcCornerStencils[_c][c] , cornerLoopData.pcSize[c][_c] , cornerLoopData.pcIndices[c][_c] );
+				_SetSupport( stencilData[depth].pcBCornerSupports[_c][c] , stencilData[depth].pcBCornerStencils[_c][c] , bCornerLoopData.pcSize[c][_c] , bCornerLoopData.pcIndices[c][_c] );
+			}
+		}
 	}
 	if( _pointEvaluator ) delete _pointEvaluator;
 	_pointEvaluator = new PointEvaluator< UIntPack< FEMSigs ... > , IsotropicUIntPack< Dim , PointD > >( maxDepth );
@@ -368,12 +382,12 @@ CumulativeDerivativeValues< V , Dim , _PointD > FEMTree< Dim , Real >::_getCorne
 				}
 			}
 		};
-		if( isInterior ) AddToValuesInterior( loopData.ccSize[corner] , loopData.ccIndices[corner] , neighborKey.neighbors[ node->depth() ] , evaluator.stencilData[d].ccCornerStencil[corner] , solution );
+		if( isInterior ) AddToValuesInterior( evaluator.stencilData[d].ccCornerSupport[corner].size[_PointD] , evaluator.stencilData[d].ccCornerSupport[corner].indices[_PointD] , neighborKey.neighbors[ node->depth() ] , evaluator.stencilData[d].ccCornerStencil[corner] , solution );
 		else             AddToValuesExterior( loopData.ccSize[corner] , loopData.ccIndices[corner] , d , cIdx , neighborKey.neighbors[ node->depth() ] , solution , false );
 		if( d>0 )
 		{
 			int _corner = int( node - node->parent->children );
-			if( isInterior ) AddToValuesInterior( loopData.pcSize[corner][_corner] , loopData.pcIndices[corner][_corner] , neighborKey.neighbors[ node->parent->depth() ] , evaluator.stencilData[d].pcCornerStencils[_corner][corner] , coarseSolution );
+			if( isInterior ) AddToValuesInterior( evaluator.stencilData[d].pcCornerSupports[_corner][corner].size[_PointD] , evaluator.stencilData[d].pcCornerSupports[_corner][corner].indices[_PointD] , neighborKey.neighbors[ node->parent->depth() ] , evaluator.stencilData[d].pcCornerStencils[_corner][corner] , coarseSolution );
 			else             AddToValuesExterior( loopData.pcSize[corner][_corner] , loopData.pcIndices[corner][_corner] , d , cIdx , neighborKey.neighbors[ node->parent->depth() ] , coarseSolution , true );
 		}
 		// If there could be finer neighbors whose support overlaps the point
@@ -382,7 +396,7 @@ CumulativeDerivativeValues< V , Dim , _PointD > FEMTree< Dim , Real >::_getCorne
 			typename FEMTreeNode::template ConstNeighbors< SupportSizes > cNeighbors;
 			if( neighborKey.getChildNeighbors( corner , node->depth() , cNeighbors ) )
 			{
-				if( isInterior ) AddToValuesInterior( loopData.ccSize[corner] , loopData.ccIndices[corner] , cNeighbors , evaluator.stencilData[d+1].ccCornerStencil[corner] , solution );
+				if( isInterior ) AddToValuesInterior( evaluator.stencilData[d+1].ccCornerSupport[corner].size[_PointD] , evaluator.stencilData[d+1].ccCornerSupport[corner].indices[_PointD] , cNeighbors , evaluator.stencilData[d+1].ccCornerStencil[corner] , solution );
 				else
 				{
 					LocalDepth _d=d+1 ; LocalOffset _cIdx;
@@ -446,12 +460,12 @@ CumulativeDerivativeValues< V , Dim , _PointD > FEMTree< Dim , Real >::_getCorne
 				}
 			}
 		};
-		if( isInterior ) AddToValuesInterior( loopData.ccSize[corner] , loopData.ccIndices[corner] , neighborKey.neighbors[ node->depth() ] , evaluator.stencilData[d].ccBCornerStencil[corner] , solution );
+		if( isInterior ) AddToValuesInterior( evaluator.stencilData[d].ccBCornerSupport[corner].size[_PointD] , evaluator.stencilData[d].ccBCornerSupport[corner].indices[_PointD] , neighborKey.neighbors[ node->depth() ] , evaluator.stencilData[d].ccBCornerStencil[corner] , solution );
 		else             AddToValuesExterior( loopData.ccSize[corner] , loopData.ccIndices[corner] , d , cIdx , neighborKey.neighbors[ node->depth() ] , solution , false );
 		if( d>0 )
 		{
 			int _corner = int( node - node->parent->children );
-			if( isInterior ) AddToValuesInterior( loopData.pcSize[corner][_corner] , loopData.pcIndices[corner][_corner] , neighborKey.neighbors[ node->parent->depth() ] , evaluator.stencilData[d].pcBCornerStencils[_corner][corner] , coarseSolution );
+			if( isInterior ) AddToValuesInterior( evaluator.stencilData[d].pcBCornerSupports[_corner][corner].size[_PointD] , evaluator.stencilData[d].pcBCornerSupports[_corner][corner].indices[_PointD] , neighborKey.neighbors[ node->parent->depth() ] , evaluator.stencilData[d].pcBCornerStencils[_corner][corner] , coarseSolution );
 			else             AddToValuesExterior( loopData.pcSize[corner][_corner] , loopData.pcIndices[corner][_corner] , d , cIdx , neighborKey.neighbors[ node->parent->depth() ] , coarseSolution , true );
 		}
 		// If there could be finer neighbors whose support overlaps the point
@@ -460,7 +474,7 @@ CumulativeDerivativeValues< V , Dim , _PointD > FEMTree< Dim , Real >::_getCorne
 			typename FEMTreeNode::template ConstNeighbors< BCornerSizes > cNeighbors;
 			if( neighborKey.getChildNeighbors( corner , node->depth() , cNeighbors ) )
 			{
-				if( isInterior ) AddToValuesInterior( loopData.ccSize[corner] , loopData.ccIndices[corner] , cNeighbors , evaluator.stencilData[d+1].ccBCornerStencil[corner] , solution );
+				if( isInterior ) AddToValuesInterior( evaluator.stencilData[d+1].ccBCornerSupport[corner].size[_PointD] , evaluator.stencilData[d+1].ccBCornerSupport[corner].indices[_PointD] , cNeighbors , evaluator.stencilData[d+1].ccBCornerStencil[corner] , solution );
 				else
 				{
 					LocalDepth _d=d+1 ; LocalOffset _cIdx;
@@ -559,32 +573,45 @@ void FEMTree< Dim , Real >::_addEvaluation( const Coefficients& coefficients , P
 template< unsigned int Dim , class Real >
 template< class V , class Coefficients , unsigned int D , unsigned int ... DataSigs >
 void FEMTree< Dim , Real >::_addEvaluation( const Coefficients& coefficients , Point< Real , Dim > p , LocalDepth pointDepth , const PointEvaluator< UIntPack< DataSigs ... > , IsotropicUIntPack< Dim , D > >& pointEvaluator , const ConstPointSupportKey< UIntPack< FEMSignature< DataSigs >::Degree ... > >& dataKey , V &value ) const
+{
+	_addEvaluations< V , Coefficients , D , DataSigs ... >( coefficients , &p , 1 , pointDepth , pointEvaluator , dataKey , &value );
+}
+
+template< unsigned int Dim , class Real >
+template< class V , class Coefficients , unsigned int D , unsigned int ... DataSigs >
+void FEMTree< Dim , Real >::_addEvaluations( const Coefficients& coefficients , const Point< Real , Dim > *p , unsigned int count , LocalDepth pointDepth , const PointEvaluator< UIntPack< DataSigs ... > , IsotropicUIntPack< Dim , D > >& pointEvaluator , const ConstPointSupportKey< UIntPack< FEMSignature< DataSigs >::Degree ... > >& dataKey , V *values ) const
 {
 	typedef UIntPack< BSplineSupportSizes< FEMSignature< DataSigs >::Degree >::SupportSize ... > SupportSizes;
 	PointEvaluatorState< UIntPack< DataSigs ... > , ZeroUIntPack< Dim > > state;
 	unsigned int derivatives[Dim];
 	memset( derivatives , 0 , sizeof( derivatives ) );
-	typedef PointSupportKey< UIntPack< FEMSignature< DataSigs >::Degree ... > > DataKey;
 
+	// The points share the neighbors of the key, so the coefficients and offsets are looked up once per depth
+	const V* nodeCoefficients[ WindowSize< SupportSizes >::Size ];
+	LocalOffset nodeOffsets[ WindowSize< SupportSizes >::Size ];
 	for( int d=_localToGlobal( 0 ) ; d<=_localToGlobal( pointDepth ) ; d++ )
 	{
-		{
-			const FEMTreeNode* node = dataKey.neighbors[d].neighbors.data[ WindowIndex< UIntPack< BSplineSupportSizes< FEMSignature< DataSigs >::Degree >::SupportSize ... > , UIntPack< BSplineSupportSizes< FEMSignature< DataSigs >::Degree >::SupportEnd ... > >::Index ];
-			if( !node ) ERROR_OUT( "Point is not centered on a node: " , p , " " , WindowIndex< UIntPack< BSplineSupportSizes< FEMSignature< DataSigs >::Degree >::SupportSize ... > , UIntPack< BSplineSupportSizes< FEMSignature< DataSigs >::Degree >::SupportEnd ... > >::Index , " @ " , d );
-			pointEvaluator.initEvaluationState( p , _localDepth( node ) , state );
-		}
-		double scratch[Dim+1];
-		scratch[0] = 1;
+		const FEMTreeNode* node = dataKey.neighbors[d].neighbors.data[ WindowIndex< UIntPack< BSplineSupportSizes< FEMSignature< DataSigs >::Degree >::SupportSize ... > , UIntPack< BSplineSupportSizes< FEMSignature< DataSigs >::Degree >::SupportEnd ... > >::Index ];
+		if( !node ) ERROR_OUT( "Point is not centered on a node: " , p[0] , " " , WindowIndex< UIntPack< BSplineSupportSizes< FEMSignature< DataSigs >::Degree >::SupportSize ... > , UIntPack< BSplineSupportSizes< FEMSignature< DataSigs >::Degree >::SupportEnd ... > >::Index , " @ " , d );
+
+		unsigned int nodeCount = 0;
 		ConstPointer( FEMTreeNode * const ) nodes = dataKey.neighbors[d].neighbors().data;
 		for( int i=0 ; i<WindowSize< SupportSizes >::Size ; i++ ) if( _isValidFEM1Node( nodes[i] ) )
 		{
 			const V* v = coefficients( nodes[i] );
 			if( v )
 			{
-				LocalDepth d ; LocalOffset off ; _localDepthAndOffset( nodes[i] , d , off );
-				value += (*v) * (Real)state.value( off , derivatives );
+				LocalDepth _d;
+				_localDepthAndOffset( nodes[i] , _d , nodeOffsets[nodeCount] );
+				nodeCoefficients[ nodeCount++ ] = v;
 			}
 		}
+
+		for( unsigned int j=0 ; j<count ; j++ )
+		{
+			pointEvaluator.initEvaluationState( p[j] , _localDepth( node ) , state );
+			for( unsigned int i=0 ; i<nodeCount ; i++ ) values[j] += (*nodeCoefficients[i]) * (Real)state.value( nodeOffsets[i] , derivatives );
+		}
 	}
 }
 
@@ -372,6 +372,10 @@ public:
 
 		void setFromScratch( typename Scratch::EKeyValues &scratch )
 		{
+			// Size the map so that adding the scratch values does not re-hash
+			size_t sz = 0;
+			for( node_index_type i=0 ; i<(node_index_type)scratch.size() ; i++ ) sz += scratch[i].size();
+			edgeVertexMap.reserve( edgeVertexMap.size() + sz );
 			for( node_index_type i=0 ; i<(node_index_type)scratch.size() ; i++ )
 			{
 				for( int j=0 ; j<scratch[i].size() ; j++ ) edgeVertexMap[ scratch[i][j].first ] = scratch[i][j].second;
@@ -381,6 +385,10 @@ public:
 
 		void setFromScratch( typename Scratch::VKeyValues &scratch )
 		{
+			// Size the map so that adding the scratch values does not re-hash
+			size_t sz = 0;
+			for( node_index_type i=0 ; i<(node_index_type)scratch.size() ; i++ ) sz += 2*scratch[i].size();
+			vertexPairMap.reserve( vertexPairMap.size() + sz );
 			for( node_index_type i=0 ; i<(node_index_type)scratch.size() ; i++ )
 			{
 				for( int j=0 ; j<scratch[i].size() ; j++ )
@@ -395,6 +403,10 @@ public:
 
 		void setFromScratch( typename Scratch::FKeyValues &scratch )
 		{
+			// Size the map so that adding the scratch values does not re-hash
+			size_t sz = 0;
+			for( node_index_type i=0 ; i<(node_index_type)scratch.size() ; i++ ) sz += scratch[i].size();
+			faceEdgeMap.reserve( faceEdgeMap.size() + sz );
 			for( node_index_type i=0 ; i<(node_index_type)scratch.size() ; i++ )
 			{
 				for( int j=0 ; j<scratch[i].size() ; j++ )
@@ -128,6 +128,7 @@ public:
 				cSet = NullPointer( char );
 				eSet = NullPointer( char );
 				fSet = NullPointer( char );
+				_oldCCount = _oldECount = _oldFCount = 0;
 			}
 
 			~Scratch( void )
@@ -142,25 +143,31 @@ public:
 				for( size_t i=0 ; i<vKeyValues.size() ; i++ ) vKeyValues[i].clear();
 				for( size_t i=0 ; i<eKeyValues.size() ; i++ ) eKeyValues[i].clear();
 				for( size_t i=0 ; i<fKeyValues.size() ; i++ ) fKeyValues[i].clear();
-				FreePointer( cSet );
-				FreePointer( eSet );
-				FreePointer( fSet );
-				if( cellIndices.counts[0] )
+				// Only re-allocate if the flags need to grow, and only clear the part that is used by this slice
+				if( _oldCCount<cellIndices.counts[0] )
 				{
-					cSet = AllocPointer< char >( cellIndices.counts[0] );
-					memset( cSet , 0 , sizeof( char ) * cellIndices.counts[0] );
+					_oldCCount = cellIndices.counts[0];
+					FreePointer( cSet );
+					cSet = AllocPointer< char >( _oldCCount );
 				}
-				if( cellIndices.counts[1] )
+				if( _oldECount<cellIndices.counts[1] )
 				{
-					eSet = AllocPointer< char >( cellIndices.counts[1] );
-					memset( eSet , 0 , sizeof( char ) * cellIndices.counts[1] );
+					_oldECount = cellIndices.counts[1];
+					FreePointer( eSet );
+					eSet = AllocPointer< char >( _oldECount );
 				}
-				if( cellIndices.counts[2] )
+				if( _oldFCount<cellIndices.counts[2] )
 				{
-					fSet = AllocPointer< char >( cellIndices.counts[2] );
-					memset( fSet , 0 , sizeof( char ) * cellIndices.counts[2] );
+					_oldFCount = cellIndices.counts[2];
+					FreePointer( fSet );
+					fSet = AllocPointer< char >( _oldFCount );
 				}
+				if( cellIndices.counts[0] ) memset( cSet , 0 , sizeof( char ) * cellIndices.counts[0] );
+				if( cellIndices.counts[1] ) memset( eSet , 0 , sizeof( char ) * cellIndices.counts[1] );
+				if( cellIndices.counts[2] ) memset( fSet , 0 , sizeof( char ) * cellIndices.counts[2] );
 			}
+		protected:
+			size_t _oldCCount , _oldECount , _oldFCount;
 		};
 
 		LevelSetExtraction::SliceCellIndexData< Dim > cellIndices;
@@ -194,6 +201,10 @@ public:
 
 		void setFromScratch( typename Scratch::VKeyValues &scratch )
 		{
+			// Size the map so that adding the scratch values does not re-hash
+			size_t sz = 0;
+			for( unsigned int t=0 ; t<scratch.size() ; t++ ) sz += 2*scratch[t].size();
+			vertexPairMap.reserve( vertexPairMap.size() + sz );
 			for( unsigned int t=0 ; t<scratch.size() ; t++ )
 			{
 				for( int i=0 ; i<scratch[t].size() ; i++ )
@@ -207,6 +218,10 @@ public:
 
 		void setFromScratch( typename Scratch::EKeyValues &scratch )
 		{
+			// Size the map so that adding the scratch values does not re-hash
+			size_t sz = 0;
+			for( unsigned int t=0 ; t<scratch.size() ; t++ ) sz += scratch[t].size();
+			edgeVertexMap.reserve( edgeVertexMap.size() + sz );
 			for( unsigned int t=0 ; t<scratch.size() ; t++ )
 			{
 				for( int i=0 ; i<scratch[t].size() ; i++ ) edgeVertexMap[ scratch[t][i].first ] = scratch[t][i].second;
@@ -216,6 +231,10 @@ public:
 
 		void setFromScratch( typename Scratch::FKeyValues &scratch )
 		{
+			// Size the map so that adding the scratch values does not re-hash
+			size_t sz = 0;
+			for( unsigned int t=0 ; t<scratch.size() ; t++ ) sz += scratch[t].size();
+			faceEdgeMap.reserve( faceEdgeMap.size() + sz );
 			for( unsigned int t=0 ; t<scratch.size() ; t++ )
 			{
 				for( int i=0 ; i<scratch[t].size() ; i++ )
@@ -357,6 +376,7 @@ public:
 				fKeyValues.resize( ThreadPool::NumThreads() );
 				eSet = NullPointer( char );
 				fSet = NullPointer( char );
+				_oldECount = _oldFCount = 0;
 			}
 
 			~Scratch( void )
@@ -370,19 +390,24 @@ public:
 				for( size_t i=0 ; i<vKeyValues.size() ; i++ ) vKeyValues[i].clear();
 				for( size_t i=0 ; i<eKeyValues.size() ; i++ ) eKeyValues[i].clear();
 				for( size_t i=0 ; i<fKeyValues.size() ; i++ ) fKeyValues[i].clear();
-				FreePointer( eSet );
-				FreePointer( fSet );
-				if( cellIndices.counts[0] )
+				// Only re-allocate if the flags need to grow, and only clear the part that is used by this slab
+				if( _oldECount<cellIndices.counts[0] )
 				{
-					eSet = AllocPointer< char >( cellIndices.counts[0] );
-					memset( eSet , 0 , sizeof( char ) * cellIndices.counts[0] );
+					_oldECount = cellIndices.counts[0];
+					FreePointer( eSet );
+					eSet = AllocPointer< char >( _oldECount );
 				}
-				if( cellIndices.counts[1] )
+				if( _oldFCount<cellIndices.counts[1] )
 				{
-					fSet = AllocPointer< char >( cellIndices.counts[1] );
-					memset( fSet , 0 , sizeof( char ) * cellIndices.counts[1] );
+					_oldFCount = cellIndices.counts[1];
+					FreePointer( fSet );
+					fSet = AllocPointer< char >( _oldFCount );
 				}
+				if( cellIndices.counts[0] ) memset( eSet , 0 , sizeof( char ) * cellIndices.counts[0] );
+				if( cellIndices.counts[1] ) memset( fSet , 0 , sizeof( char ) * cellIndices.counts[1] );
 			}
+		protected:
+			size_t _oldECount , _oldFCount;
 		};
 
 		LevelSetExtraction::SlabCellIndexData< Dim > cellIndices;
@@ -409,6 +434,10 @@ public:
 
 		void setFromScratch( typename Scratch::VKeyValues &scratch )
 		{
+			// Size the map so that adding the scratch values does not re-hash
+			size_t sz = 0;
+			for( unsigned int t=0 ; t<scratch.size() ; t++ ) sz += 2*scratch[t].size();
+			vertexPairMap.reserve( vertexPairMap.size() + sz );
 			for( unsigned int t=0 ; t<scratch.size() ; t++ )
 			{
 				for( int i=0 ; i<scratch[t].size() ; i++ )
@@ -422,6 +451,10 @@ public:
 
 		void setFromScratch( typename Scratch::EKeyValues &scratch )
 		{
+			// Size the map so that adding the scratch values does not re-hash
+			size_t sz = 0;
+			for( unsigned int t=0 ; t<scratch.size() ; t++ ) sz += scratch[t].size();
+			edgeVertexMap.reserve( edgeVertexMap.size() + sz );
 			for( unsigned int t=0 ; t<scratch.size() ; t++ )
 			{
 				for( int i=0 ; i<scratch[t].size() ; i++ ) edgeVertexMap[ scratch[t][i].first ] = scratch[t][i].second;
@@ -431,6 +464,10 @@ public:
 
 		void setFromScratch( typename Scratch::FKeyValues &scratch )
 		{
+			// Size the map so that adding the scratch values does not re-hash
+			size_t sz = 0;
+			for( unsigned int t=0 ; t<scratch.size() ; t++ ) sz += scratch[t].size();
+			faceEdgeMap.reserve( faceEdgeMap.size() + sz );
 			for( unsigned int t=0 ; t<scratch.size() ; t++ )
 			{
 				for( int i=0 ; i<scratch[t].size() ; i++ )
@@ -795,14 +832,17 @@ public:
 	}
 
 	template< unsigned int ... FEMSigs >
-	static void SetSliceCornerValuesAndMCIndices( const FEMTree< Dim , Real >& tree , ConstPointer( Real ) coefficients , ConstPointer( Real ) coarseCoefficients , Real isoValue , LocalDepth depth , LocalDepth fullDepth , int slice ,         std::vector< SlabValues >& slabValues , const _Evaluator< UIntPack< FEMSigs ... > , 1 >& evaluator )
+	// Returns the number of nodes processed
+	static size_t SetSliceCornerValuesAndMCIndices( const FEMTree< Dim , Real >& tree , ConstPointer( Real ) coefficients , ConstPointer( Real ) coarseCoefficients , Real isoValue , LocalDepth depth , LocalDepth fullDepth , int slice ,         std::vector< SlabValues >& slabValues , const _Evaluator< UIntPack< FEMSigs ... > , 1 >& evaluator )
 	{
-		if( slice>0          ) SetSliceCornerValuesAndMCIndices< FEMSigs ... >( tree , coefficients , coarseCoefficients , isoValue , depth , fullDepth , slice , HyperCube::FRONT , slabValues , evaluator );
-		if( slice<(1<<depth) ) SetSliceCornerValuesAndMCIndices< FEMSigs ... >( tree , coefficients , coarseCoefficients , isoValue , depth , fullDepth , slice , HyperCube::BACK  , slabValues , evaluator );
+		size_t nodeCount = 0;
+		if( slice>0          ) nodeCount += SetSliceCornerValuesAndMCIndices< FEMSigs ... >( tree , coefficients , coarseCoefficients , isoValue , depth , fullDepth , slice , HyperCube::FRONT , slabValues , evaluator );
+		if( slice<(1<<depth) ) nodeCount += SetSliceCornerValuesAndMCIndices< FEMSigs ... >( tree , coefficients , coarseCoefficients , isoValue , depth , fullDepth , slice , HyperCube::BACK  , slabValues , evaluator );
+		return nodeCount;
 	}
 
 	template< unsigned int ... FEMSigs >
-	static void SetSliceCornerValuesAndMCIndices( const FEMTree< Dim , Real >& tree , ConstPointer( Real ) coefficients , ConstPointer( Real ) coarseCoefficients , Real isoValue , LocalDepth depth , LocalDepth fullDepth , int slice , HyperCube::Direction zDir , std::vector< SlabValues >& slabValues , const _Evaluator< UIntPack< FEMSigs ... > , 1 >& evaluator )
+	static size_t SetSliceCornerValuesAndMCIndices( const FEMTree< Dim , Real >& tree , ConstPointer( Real ) coefficients , ConstPointer( Real ) coarseCoefficients , Real isoValue , LocalDepth depth , LocalDepth fullDepth , int slice , HyperCube::Direction zDir , std::vector< SlabValues >& slabValues , const _Evaluator< UIntPack< FEMSigs ... > , 1 >& evaluator )
 	{
 		static const unsigned int FEMDegrees[] = { FEMSignature< FEMSigs >::Degree ... };
 		SliceValues& sValues = slabValues[depth].sliceValues( slice );
@@ -825,9 +865,8 @@ public:
 				{
 					const typename LevelSetExtraction::SliceCellIndexData< Dim >::template CellIndices<0> &cIndices = sValues.cellIndices.template indices<0>( leaf );
 
-					bool isInterior = tree._isInteriorlySupported( UIntPack< FEMSignature< FEMSigs >::Degree ... >() , leaf->parent );
-					if( useBoundaryEvaluation ) bNeighborKey.getNeighbors( leaf );
-					else                         neighborKey.getNeighbors( leaf );
+					// The neighbors are only gathered once a corner that has not been set by an adjacent leaf is encountered
+					bool isInterior = false , hasNeighbors = false;
 
 					for( typename HyperCube::Cube< Dim-1 >::template Element< 0 > _c ; _c<HyperCube::Cube< Dim-1 >::template ElementNum< 0 >() ; _c++ )
 					{
@@ -835,6 +874,13 @@ public:
 						node_index_type vIndex = cIndices[_c.index];
 						if( !sScratch.cSet[vIndex] )
 						{
+							if( !hasNeighbors )
+							{
+								isInterior = tree._isInteriorlySupported( UIntPack< FEMSignature< FEMSigs >::Degree ... >() , leaf->parent );
+								if( useBoundaryEvaluation ) bNeighborKey.getNeighbors( leaf );
+								else                         neighborKey.getNeighbors( leaf );
+								hasNeighbors = true;
+							}
 							if( sValues.cornerGradients )
 							{
 								CumulativeDerivativeValues< Real , Dim , 1 > p;
@@ -870,6 +916,7 @@ public:
 			}
 		}
 		);
+		return tree._sNodesEnd(depth,slice-(zDir==HyperCube::BACK ? 0 : 1)) - tree._sNodesBegin(depth,slice-(zDir==HyperCube::BACK ? 0 : 1));
 	}
 
 	static void SetMCIndices( const FEMTree< Dim , Real >& tree , Real isoValue , LocalDepth depth , LocalDepth fullDepth , int slice , std::vector< SlabValues >& slabValues )
@@ -946,88 +993,102 @@ public:
 						if( densityWeights ) weightKey.getNeighbors( leaf );
 						if constexpr( HasData ) if( data ) dataKey.getNeighbors( leaf );
 
+						// Compute the positions of the leaf's iso-vertices first, and then evaluate the rest of their attributes together
+						Vertex leafVertices[ HyperCube::Cube< Dim-1 >::template ElementNum< 1 >() ];
+						typename HyperCube::Cube< Dim-1 >::template Element< 1 > leafEdges[ HyperCube::Cube< Dim-1 >::template ElementNum< 1 >() ];
+						unsigned int leafVertexCount = 0;
 						for( typename HyperCube::Cube< Dim-1 >::template Element< 1 > _e ; _e<HyperCube::Cube< Dim-1 >::template ElementNum< 1 >() ; _e++ )
-							if( HyperCube::Cube< 1 >::HasMCRoots( HyperCube::Cube< Dim-1 >::ElementMCIndex( _e , sValues.mcIndices[idx] ) ) )
+							if( HyperCube::Cube< 1 >::HasMCRoots( HyperCube::Cube< Dim-1 >::ElementMCIndex( _e , sValues.mcIndices[idx] ) ) && !sScratch.eSet[ eIndices[_e.index] ] )
 							{
-								typename HyperCube::Cube< Dim >::template Element< 1 > e( zDir , _e.index );
-								node_index_type vIndex = eIndices[_e.index];
-								volatile char &edgeSet = sScratch.eSet[vIndex];
+								GetIsoVertex( tree , nonLinearFit , gradientNormals , isoValue , leaf , _e , zDir , sValues , leafVertices[leafVertexCount] );
+								leafEdges[ leafVertexCount++ ] = _e;
+							}
+						{
+							Point< Real , Dim > s;
+							Real width;
+							tree._startAndWidth( leaf , s , width );
+							Point< Real , Dim > center( s[0] + width/2 , s[1] + width/2 , s[2] + width/2 );
+							SetIsoVertexAttributes< WeightDegree , DataSig >( tree , pointEvaluator , densityWeights , data , weightKey , dataKey , leaf , center , leafVertices , leafVertexCount , zeroData );
+						}
+
+						for( unsigned int v=0 ; v<leafVertexCount ; v++ )
+						{
+							typename HyperCube::Cube< Dim-1 >::template Element< 1 > _e = leafEdges[v];
+							typename HyperCube::Cube< Dim >::template Element< 1 > e( zDir , _e.index );
+							node_index_type vIndex = eIndices[_e.index];
+							volatile char &edgeSet = sScratch.eSet[vIndex];
+							const Vertex &vertex = leafVertices[v];
+							Key key = _EdgeIndex( leaf , e );
+							bool stillOwner = false;
+							std::pair< node_index_type , Vertex > hashed_vertex;
+							{
+								std::lock_guard< std::mutex > lock( _pointInsertionMutex );
 								if( !edgeSet )
 								{
-									Vertex vertex;
-									Key key = _EdgeIndex( leaf , e );
-									GetIsoVertex< WeightDegree , DataSig >( tree , nonLinearFit , gradientNormals , pointEvaluator , densityWeights , data , isoValue , weightKey , dataKey , leaf , _e , zDir , sValues , vertex , zeroData );
-									bool stillOwner = false;
-									std::pair< node_index_type , Vertex > hashed_vertex;
+									vertices.write( vertex );
+									edgeSet = 1;
+									hashed_vertex = std::pair< node_index_type , Vertex >( vOffset , vertex );
+									sValues.edgeKeys[ vIndex ] = key;
+									vOffset++;
+									stillOwner = true;
+								}
+							}
+							if( stillOwner )
+							{
+								sScratch.eKeyValues[ thread ].push_back( std::pair< Key , std::pair< node_index_type , Vertex > >( key , hashed_vertex ) );
+								// We only need to pass the iso-vertex down if the edge it lies on is adjacent to a coarser leaf
+								auto IsNeeded = [&]( unsigned int depth )
+								{
+									bool isNeeded = false;
+									typename HyperCube::Cube< Dim >::template IncidentCubeIndex< 1 > my_ic = HyperCubeTables< Dim , 1 >::IncidentCube[e.index];
+									for( typename HyperCube::Cube< Dim >::template IncidentCubeIndex< 1 > ic ; ic<HyperCube::Cube< Dim >::template IncidentCubeNum< 1 >() ; ic++ ) if( ic!=my_ic )
 									{
-										std::lock_guard< std::mutex > lock( _pointInsertionMutex );
-										if( !edgeSet )
-										{
-											vertices.write( vertex );
-											edgeSet = 1;
-											hashed_vertex = std::pair< node_index_type , Vertex >( vOffset , vertex );
-											sValues.edgeKeys[ vIndex ] = key;
-											vOffset++;
-											stillOwner = true;
-										}
+										unsigned int xx = HyperCubeTables< Dim , 1 >::CellOffset[e.index][ic.index];
+										isNeeded |= !tree._isValidSpaceNode( neighborKey.neighbors[ tree._localToGlobal( depth ) ].neighbors.data[xx] );
 									}
-									if( stillOwner )
+									return isNeeded;
+								};
+								if( IsNeeded( depth ) )
+								{
+									const typename HyperCube::Cube< Dim >::template Element< Dim-1 > *f = HyperCubeTables< Dim , 1 , Dim-1 >::OverlapElements[e.index];
+									for( int k=0 ; k<HyperCubeTables< Dim , 1 , Dim-1 >::OverlapElementNum ; k++ )
 									{
-										sScratch.eKeyValues[ thread ].push_back( std::pair< Key , std::pair< node_index_type , Vertex > >( key , hashed_vertex ) );
-										// We only need to pass the iso-vertex down if the edge it lies on is adjacent to a coarser leaf
-										auto IsNeeded = [&]( unsigned int depth )
+										TreeNode* node = leaf;
+										LocalDepth _depth = depth;
+										int _slice = slice;
+										bool _cross = false;
+										while( tree._isValidSpaceNode( node->parent ) && HyperCubeTables< Dim , Dim-1 , 0 >::Overlap[f[k].index][(unsigned int)(node-node->parent->children) ] )
 										{
-											bool isNeeded = false;
-											typename HyperCube::Cube< Dim >::template IncidentCubeIndex< 1 > my_ic = HyperCubeTables< Dim , 1 >::IncidentCube[e.index];
-											for( typename HyperCube::Cube< Dim >::template IncidentCubeIndex< 1 > ic ; ic<HyperCube::Cube< Dim >::template IncidentCubeNum< 1 >() ; ic++ ) if( ic!=my_ic )
+											if( _slice&1 ) _cross = true;
+											node = node->parent , _depth-- , _slice >>= 1;
+											SliceValues &_sValues = slabValues[_depth].sliceValues( _slice );
+											typename SliceValues::Scratch &_sScratch = slabValues[_depth].sliceScratch( _slice );
+
+											if( _depth>=fullDepth && !_cross )
 											{
-												unsigned int xx = HyperCubeTables< Dim , 1 >::CellOffset[e.index][ic.index];
-												isNeeded |= !tree._isValidSpaceNode( neighborKey.neighbors[ tree._localToGlobal( depth ) ].neighbors.data[xx] );
+												const typename LevelSetExtraction::SliceCellIndexData< Dim >::template CellIndices<1> &_eIndices = _sValues.cellIndices.template indices<1>( node );
+												node_index_type _vIndex = _eIndices[_e.index];
+												_sScratch.eSet[_vIndex] = 1;
 											}
-											return isNeeded;
-										};
-										if( IsNeeded( depth ) )
-										{
-											const typename HyperCube::Cube< Dim >::template Element< Dim-1 > *f = HyperCubeTables< Dim , 1 , Dim-1 >::OverlapElements[e.index];
-											for( int k=0 ; k<HyperCubeTables< Dim , 1 , Dim-1 >::OverlapElementNum ; k++ )
+
+											if( _cross )
+											{
+												XSliceValues& _xValues = slabValues[_depth].xSliceValues( _slice );
+												typename XSliceValues::Scratch &_xScratch = slabValues[_depth].xSliceScratch( _slice );
+												_xScratch.eKeyValues[ thread ].push_back( std::pair< Key , std::pair< node_index_type , Vertex > >( key , hashed_vertex ) );
+											}
+											else
 											{
-												TreeNode* node = leaf;
-												LocalDepth _depth = depth;
-												int _slice = slice;
-												bool _cross = false;
-												while( tree._isValidSpaceNode( node->parent ) && HyperCubeTables< Dim , Dim-1 , 0 >::Overlap[f[k].index][(unsigned int)(node-node->parent->children) ] )
-												{
-													if( _slice&1 ) _cross = true;
-													node = node->parent , _depth-- , _slice >>= 1;
-													SliceValues &_sValues = slabValues[_depth].sliceValues( _slice );
-													typename SliceValues::Scratch &_sScratch = slabValues[_depth].sliceScratch( _slice );
-
-													if( _depth>=fullDepth && !_cross )
-													{
-														const typename LevelSetExtraction::SliceCellIndexData< Dim >::template CellIndices<1> &_eIndices = _sValues.cellIndices.template indices<1>( node );
-														node_index_type _vIndex = _eIndices[_e.index];
-														_sScratch.eSet[_vIndex] = 1;
-													}
-
-													if( _cross )
-													{
-														XSliceValues& _xValues = slabValues[_depth].xSliceValues( _slice );
-														typename XSliceValues::Scratch &_xScratch = slabValues[_depth].xSliceScratch( _slice );
-														_xScratch.eKeyValues[ thread ].push_back( std::pair< Key , std::pair< node_index_type , Vertex > >( key , hashed_vertex ) );
-													}
-													else
-													{
-														SliceValues& _sValues = slabValues[_depth].sliceValues( _slice );
-														typename SliceValues::Scratch &_sScratch = slabValues[_depth].sliceScratch( _slice );
-														_sScratch.eKeyValues[ thread ].push_back( std::pair< Key , std::pair< node_index_type , Vertex > >( key , hashed_vertex ) );
-													}
-													if( !IsNeeded( _depth ) ) break;
-												}
+												SliceValues& _sValues = slabValues[_depth].sliceValues( _slice );
+												typename SliceValues::Scratch &_sScratch = slabValues[_depth].sliceScratch( _slice );
+												_sScratch.eKeyValues[ thread ].push_back( std::pair< Key , std::pair< node_index_type , Vertex > >( key , hashed_vertex ) );
 											}
+											if( !IsNeeded( _depth ) ) break;
 										}
 									}
 								}
 							}
+						}
 					}
 				}
 			}
@@ -1078,76 +1139,91 @@ public:
 						neighborKey.getNeighbors( leaf );
 						if( densityWeights ) weightKey.getNeighbors( leaf );
 						if constexpr( HasData ) if( data ) dataKey.getNeighbors( leaf );
+
+						// Compute the positions of the leaf's iso-vertices first, and then evaluate the rest of their attributes together
+						Vertex leafVertices[ HyperCube::Cube< Dim-1 >::template ElementNum< 0 >() ];
+						typename HyperCube::Cube< Dim-1 >::template Element< 0 > leafCorners[ HyperCube::Cube< Dim-1 >::template ElementNum< 0 >() ];
+						unsigned int leafVertexCount = 0;
 						for( typename HyperCube::Cube< Dim-1 >::template Element< 0 > _c ; _c<HyperCube::Cube< Dim-1 >::template ElementNum< 0 >() ; _c++ )
 						{
 							typename HyperCube::Cube< Dim >::template Element< 1 > e( HyperCube::CROSS , _c.index );
-							unsigned int _mcIndex = HyperCube::Cube< Dim >::ElementMCIndex( e , mcIndex );
-							if( HyperCube::Cube< 1 >::HasMCRoots( _mcIndex ) )
+							if( HyperCube::Cube< 1 >::HasMCRoots( HyperCube::Cube< Dim >::ElementMCIndex( e , mcIndex ) ) && !xScratch.eSet[ eIndices[_c.index] ] )
 							{
-								node_index_type vIndex = eIndices[_c.index];
-								volatile char &edgeSet = xScratch.eSet[vIndex];
+								GetIsoVertex( tree , nonLinearFit , gradientNormals , isoValue , leaf , _c , bCoordinate , fCoordinate , bValues , fValues , leafVertices[leafVertexCount] );
+								leafCorners[ leafVertexCount++ ] = _c;
+							}
+						}
+						{
+							Point< Real , Dim > s;
+							Real w;
+							tree._startAndWidth( leaf , s , w );
+							Point< Real , Dim > center( s[0] + w/2 , s[1] + w/2 , (bCoordinate+fCoordinate)/2 );
+							SetIsoVertexAttributes< WeightDegree , DataSig >( tree , pointEvaluator , densityWeights , data , weightKey , dataKey , leaf , center , leafVertices , leafVertexCount , zeroData );
+						}
+
+						for( unsigned int v=0 ; v<leafVertexCount ; v++ )
+						{
+							typename HyperCube::Cube< Dim-1 >::template Element< 0 > _c = leafCorners[v];
+							typename HyperCube::Cube< Dim >::template Element< 1 > e( HyperCube::CROSS , _c.index );
+							node_index_type vIndex = eIndices[_c.index];
+							volatile char &edgeSet = xScratch.eSet[vIndex];
+							const Vertex &vertex = leafVertices[v];
+							Key key = _EdgeIndex( leaf , e.index );
+							bool stillOwner = false;
+							std::pair< node_index_type , Vertex > hashed_vertex;
+							{
+								std::lock_guard< std::mutex > lock( _pointInsertionMutex );
 								if( !edgeSet )
 								{
-									Vertex vertex;
-									Key key = _EdgeIndex( leaf , e.index );
-									GetIsoVertex< WeightDegree , DataSig >( tree , nonLinearFit , gradientNormals , pointEvaluator , densityWeights , data , isoValue , weightKey , dataKey , leaf , _c , bCoordinate , fCoordinate , bValues , fValues , vertex , zeroData );
-									bool stillOwner = false;
-									std::pair< node_index_type , Vertex > hashed_vertex;
+									vertices.write( vertex );
+									edgeSet = 1;
+									hashed_vertex = std::pair< node_index_type , Vertex >( vOffset , vertex );
+									xValues.edgeKeys[ vIndex ] = key;
+									vOffset++;
+									stillOwner = true;
+								}
+							}
+							if( stillOwner )
+							{
+								
+								xScratch.eKeyValues[ thread ].push_back( std::pair< Key , std::pair< node_index_type , Vertex > >( key , hashed_vertex ) );
+
+								// We only need to pass the iso-vertex down if the edge it lies on is adjacent to a coarser leaf
+								auto IsNeeded = [&]( unsigned int depth )
+								{
+									bool isNeeded = false;
+									typename HyperCube::Cube< Dim >::template IncidentCubeIndex< 1 > my_ic = HyperCubeTables< Dim , 1 >::IncidentCube[e.index];
+									for( typename HyperCube::Cube< Dim >::template IncidentCubeIndex< 1 > ic ; ic<HyperCube::Cube< Dim >::template IncidentCubeNum< 1 >() ; ic++ ) if( ic!=my_ic )
 									{
-										std::lock_guard< std::mutex > lock( _pointInsertionMutex );
-										if( !edgeSet )
-										{
-											vertices.write( vertex );
-											edgeSet = 1;
-											hashed_vertex = std::pair< node_index_type , Vertex >( vOffset , vertex );
-											xValues.edgeKeys[ vIndex ] = key;
-											vOffset++;
-											stillOwner = true;
-										}
+										unsigned int xx = HyperCubeTables< Dim , 1 >::CellOffset[e.index][ic.index];
+										isNeeded |= !tree._isValidSpaceNode( neighborKey.neighbors[ tree._localToGlobal( depth ) ].neighbors.data[xx] );
 									}
-									if( stillOwner )
+									return isNeeded;
+								};
+								if( IsNeeded( depth ) )
+								{
+									const typename HyperCube::Cube< Dim >::template Element< Dim-1 > *f = HyperCubeTables< Dim , 1 , Dim-1 >::OverlapElements[e.index];
+									for( int k=0 ; k<2 ; k++ )
 									{
-										
-										xScratch.eKeyValues[ thread ].push_back( std::pair< Key , std::pair< node_index_type , Vertex > >( key , hashed_vertex ) );
-
-										// We only need to pass the iso-vertex down if the edge it lies on is adjacent to a coarser leaf
-										auto IsNeeded = [&]( unsigned int depth )
+										TreeNode* node = leaf;
+										LocalDepth _depth = depth;
+										int _slab = slab;
+										// As long as we are still in the tree and the parent is also adjacent to the node
+										while( tree._isValidSpaceNode( node->parent ) && HyperCubeTables< Dim , Dim-1 , 0 >::Overlap[f[k].index][(unsigned int)(node-node->parent->children) ] )
 										{
-											bool isNeeded = false;
-											typename HyperCube::Cube< Dim >::template IncidentCubeIndex< 1 > my_ic = HyperCubeTables< Dim , 1 >::IncidentCube[e.index];
-											for( typename HyperCube::Cube< Dim >::template IncidentCubeIndex< 1 > ic ; ic<HyperCube::Cube< Dim >::template IncidentCubeNum< 1 >() ; ic++ ) if( ic!=my_ic )
-											{
-												unsigned int xx = HyperCubeTables< Dim , 1 >::CellOffset[e.index][ic.index];
-												isNeeded |= !tree._isValidSpaceNode( neighborKey.neighbors[ tree._localToGlobal( depth ) ].neighbors.data[xx] );
-											}
-											return isNeeded;
-										};
-										if( IsNeeded( depth ) )
-										{
-											const typename HyperCube::Cube< Dim >::template Element< Dim-1 > *f = HyperCubeTables< Dim , 1 , Dim-1 >::OverlapElements[e.index];
-											for( int k=0 ; k<2 ; k++ )
+											node = node->parent , _depth-- , _slab >>= 1;
+											XSliceValues& _xValues = slabValues[_depth].xSliceValues( _slab );
+											typename XSliceValues::Scratch &_xScratch = slabValues[_depth].xSliceScratch( _slab );
+											_xScratch.eKeyValues[ thread ].push_back( std::pair< Key , std::pair< node_index_type , Vertex > >( key , hashed_vertex ) );
+
+											if( _depth>=fullDepth )
 											{
-												TreeNode* node = leaf;
-												LocalDepth _depth = depth;
-												int _slab = slab;
-												// As long as we are still in the tree and the parent is also adjacent to the node
-												while( tree._isValidSpaceNode( node->parent ) && HyperCubeTables< Dim , Dim-1 , 0 >::Overlap[f[k].index][(unsigned int)(node-node->parent->children) ] )
-												{
-													node = node->parent , _depth-- , _slab >>= 1;
-													XSliceValues& _xValues = slabValues[_depth].xSliceValues( _slab );
-													typename XSliceValues::Scratch &_xScratch = slabValues[_depth].xSliceScratch( _slab );
-													_xScratch.eKeyValues[ thread ].push_back( std::pair< Key , std::pair< node_index_type , Vertex > >( key , hashed_vertex ) );
-
-													if( _depth>=fullDepth )
-													{
-														const typename LevelSetExtraction::SlabCellIndexData< Dim >::template CellIndices<0> &_eIndices = _xValues.cellIndices.template indices<0>( node );
-														node_index_type _vIndex = _eIndices[_c.index];
-														_xScratch.eSet[_vIndex] = 1;
-													}
-
-													if( !IsNeeded( _depth ) ) break;
-												}
+												const typename LevelSetExtraction::SlabCellIndexData< Dim >::template CellIndices<0> &_eIndices = _xValues.cellIndices.template indices<0>( node );
+												node_index_type _vIndex = _eIndices[_c.index];
+												_xScratch.eSet[_vIndex] = 1;
 											}
+
+											if( !IsNeeded( _depth ) ) break;
 										}
 									}
 								}
@@ -1295,6 +1371,13 @@ public:
 		);
 	}
 
+	// Returns true if the face-adjacent neighbor is refined, so that the iso-edges on the shared face are set by the neighbor's children.
+	// Neighbors outside of the space (or of the extraction region) are never processed, so their children cannot set the iso-edges.
+	static bool _HasFinerNeighbor( const FEMTree< Dim , Real > &tree , const TreeNode *neighbor )
+	{
+		return IsActiveNode< Dim >( neighbor ) && tree._isValidSpaceNode( neighbor ) && IsActiveNode< Dim >( neighbor->children );
+	}
+
 	static void SetSliceIsoEdges( const LevelSetExtraction::KeyGenerator< Dim > &keyGenerator , const FEMTree< Dim , Real >& tree , LocalDepth depth , int slice , std::vector< SlabValues >& slabValues )
 	{
 		if( slice>0          ) SetSliceIsoEdges( keyGenerator , tree , depth , slice , HyperCube::FRONT , slabValues );
@@ -1331,7 +1414,7 @@ public:
 					{
 						neighborKey.getNeighbors( leaf );
 						unsigned int xx = WindowIndex< IsotropicUIntPack< Dim , 3 > , IsotropicUIntPack< Dim , 1 > >::Index + (zDir==HyperCube::BACK ? -1 : 1);
-						if( !IsActiveNode< Dim >( neighborKey.neighbors[ tree._localToGlobal( depth ) ].neighbors.data[xx] ) || !IsActiveNode< Dim >( neighborKey.neighbors[ tree._localToGlobal( depth ) ].neighbors.data[xx]->children ) )
+						if( !_HasFinerNeighbor( tree , neighborKey.neighbors[ tree._localToGlobal( depth ) ].neighbors.data[xx] ) )
 						{
 							FaceEdges fe;
 							fe.count = HyperCube::MarchingSquares::AddEdgeIndices( mcIndex , isoEdges );
@@ -1353,7 +1436,7 @@ public:
 							while( tree._isValidSpaceNode( node->parent ) && HyperCubeTables< Dim , 2 , 0 >::Overlap[f.index][(unsigned int)(node-node->parent->children) ] )
 							{
 								node = node->parent , _depth-- , _slice >>= 1;
-								if( IsActiveNode< Dim >( neighborKey.neighbors[ tree._localToGlobal( _depth ) ].neighbors.data[xx] ) && IsActiveNode< Dim >( neighborKey.neighbors[ tree._localToGlobal( _depth ) ].neighbors.data[xx]->children ) ) break;
+								if( _HasFinerNeighbor( tree , neighborKey.neighbors[ tree._localToGlobal( _depth ) ].neighbors.data[xx] ) ) break;
 								Key key = _FaceIndex( node , f );
 								SliceValues& _sValues = slabValues[_depth].sliceValues( _slice );
 								typename SliceValues::Scratch &_sScratch = slabValues[_depth].sliceScratch( _slice );
@@ -1406,7 +1489,7 @@ public:
 							unsigned char _mcIndex = HyperCube::Cube< Dim >::template ElementMCIndex< 2 >( f , mcIndex );
 
 							unsigned int xx = HyperCubeTables< Dim , 2 >::CellOffsetAntipodal[f.index];
-							if(	!xScratch.fSet[ eIndices[_e.index] ] && ( !IsActiveNode< Dim >( neighborKey.neighbors[ tree._localToGlobal( depth ) ].neighbors.data[xx] ) || !IsActiveNode< Dim >( neighborKey.neighbors[ tree._localToGlobal( depth ) ].neighbors.data[xx]->children ) ) )
+							if(	!xScratch.fSet[ eIndices[_e.index] ] && !_HasFinerNeighbor( tree , neighborKey.neighbors[ tree._localToGlobal( depth ) ].neighbors.data[xx] ) )
 							{
 								FaceEdges fe;
 								fe.count = HyperCube::MarchingSquares::AddEdgeIndices( _mcIndex , isoEdges );
@@ -1442,7 +1525,7 @@ public:
 								while( tree._isValidSpaceNode( node->parent ) && HyperCubeTables< Dim , 2 , 0 >::Overlap[f.index][(unsigned int)(node-node->parent->children) ] )
 								{
 									node = node->parent , _depth-- , _slab >>= 1;
-									if( IsActiveNode< Dim >( neighborKey.neighbors[ tree._localToGlobal( _depth ) ].neighbors.data[xx] ) && IsActiveNode< Dim >( neighborKey.neighbors[ tree._localToGlobal( _depth ) ].neighbors.data[xx]->children ) ) break;
+									if( _HasFinerNeighbor( tree , neighborKey.neighbors[ tree._localToGlobal( _depth ) ].neighbors.data[xx] ) ) break;
 									Key key = _FaceIndex( node , f );
 									XSliceValues& _xValues = slabValues[_depth].xSliceValues( _slab );
 									typename XSliceValues::Scratch &_xScratch = slabValues[_depth].xSliceScratch( _slab );
@@ -1559,27 +1642,20 @@ public:
 		);
 	}
 
-	template< unsigned int WeightDegree , unsigned int DataSig >
+	// Sets the position and gradient of the iso-vertex on the edge. The remaining attributes are set by SetIsoVertexAttributes.
 	static bool GetIsoVertex
 	(
 		const FEMTree< Dim , Real >& tree ,
 		bool nonLinearFit ,
 		bool gradientNormals ,
-		typename FEMIntegrator::template PointEvaluator< IsotropicUIntPack< Dim , DataSig > , ZeroUIntPack< Dim > > *pointEvaluator ,
-		const DensityEstimator< WeightDegree > *densityWeights ,
-		const SparseNodeData< ProjectiveData< Data , Real > , IsotropicUIntPack< Dim , DataSig > > *data ,
 		Real isoValue ,
-		ConstPointSupportKey< IsotropicUIntPack< Dim , WeightDegree > >& weightKey ,
-		ConstPointSupportKey< IsotropicUIntPack< Dim , FEMSignature< DataSig >::Degree > > &dataKey ,
 		const TreeNode *node ,
 		typename HyperCube::template Cube< Dim-1 >::template Element< 1 > _e ,
 		HyperCube::Direction zDir ,
 		const SliceValues& sValues ,
-		Vertex& vertex ,
-		const Data &zeroData
+		Vertex& vertex
 	)
 	{
-		static const unsigned int DataDegree = FEMSignature< DataSig >::Degree;
 		Point< Real , Dim > position , gradient;
 		int c0 , c1;
 		const typename HyperCube::Cube< Dim-1 >::template Element< 0 > *_c = HyperCubeTables< Dim-1 , 1 , 0 >::OverlapElements[_e.index];
@@ -1643,59 +1719,26 @@ public:
 		}
 		position[o] = Real( start + width*averageRoot );
 		gradient = dx0 * (Real)( 1.-averageRoot ) + dx1 * (Real)averageRoot;
-		Real depth = (Real)1.;
-		Data dataValue;
-		if( densityWeights )
-		{
-			Real weight;
-			tree._getSampleDepthAndWeight( *densityWeights , node , position , weightKey , depth , weight );
-		}
-		if constexpr( HasData ) if( data )
-		{
-			if( DataDegree==0 ) 
-			{
-				Point< Real , 3 > center( s[0] + width/2 , s[1] + width/2 , s[2] + width/2 );
-				ProjectiveData< Data , Real > pValue( zeroData );
-				tree.template _addEvaluation< ProjectiveData< Data , Real > , SparseNodeData< ProjectiveData< Data , Real > , IsotropicUIntPack< Dim , DataSig > > , 0 >( *data , center , *pointEvaluator , dataKey , pValue );
-				dataValue = pValue.weight ? pValue.value() : zeroData;
-			}
-			else
-			{
-				ProjectiveData< Data , Real > pValue( zeroData );
-				tree.template _addEvaluation< ProjectiveData< Data , Real > , SparseNodeData< ProjectiveData< Data , Real > , IsotropicUIntPack< Dim , DataSig > > , 0 >( *data , position , *pointEvaluator , dataKey , pValue );
-				dataValue = pValue.weight ? pValue.value() : zeroData;
-			}
-		}
 		vertex.template get<0>() = position;
 		vertex.template get<1>() = gradient;
-		vertex.template get<2>() = depth;
-		if constexpr( HasData ) vertex.template get<3>() = dataValue;
 		return true;
 	}
 
-	template< unsigned int WeightDegree , unsigned int DataSig >
 	static bool GetIsoVertex
 	(
 		const FEMTree< Dim , Real > &tree ,
 		bool nonLinearFit ,
 		bool gradientNormals ,
-		typename FEMIntegrator::template PointEvaluator< IsotropicUIntPack< Dim , DataSig > , ZeroUIntPack< Dim > > *pointEvaluator ,
-		const DensityEstimator< WeightDegree > *densityWeights ,
-		const SparseNodeData< ProjectiveData< Data , Real > , IsotropicUIntPack< Dim , DataSig > > *data ,
 		Real isoValue ,
-		ConstPointSupportKey< IsotropicUIntPack< Dim , WeightDegree > > &weightKey ,
-		ConstPointSupportKey< IsotropicUIntPack< Dim , FEMSignature< DataSig >::Degree > > &dataKey ,
 		const TreeNode *node ,
 		typename HyperCube::template Cube< Dim-1 >::template Element< 0 > _c ,
 		Real bCoordinate ,
 		Real fCoordinate ,
 		const SliceValues &bValues ,
 		const SliceValues &fValues ,
-		Vertex &vertex ,
-		const Data &zeroData
+		Vertex &vertex
 	)
 	{
-		static const unsigned int DataDegree = FEMSignature< DataSig >::Degree;
 		Point< Real , Dim > position , gradient;
 
 		const typename LevelSetExtraction::SliceCellIndexData< Dim >::template CellIndices<0> &idx0 = bValues.cellIndices.template indices<0>( node );
@@ -1754,34 +1797,59 @@ public:
 		}
 		position[2] = Real( bCoordinate + (fCoordinate-bCoordinate)*averageRoot );
 		gradient = dx0 * (Real)( 1.-averageRoot ) + dx1 * (Real)averageRoot;
-		Real depth = (Real)1.;
-		Data dataValue;
-		if( densityWeights )
-		{
-			Real weight;
-			tree._getSampleDepthAndWeight( *densityWeights , node , position , weightKey , depth , weight );
-		}
+		vertex.template get<0>() = position;
+		vertex.template get<1>() = gradient;
+		return true;
+	}
+
+	// Sets the density-based depth and the data of the iso-vertices of a leaf.
+	// The vertices share the leaf's neighbor keys, so the density weights and the data coefficients are only looked up once for all of them.
+	template< unsigned int WeightDegree , unsigned int DataSig >
+	static void SetIsoVertexAttributes
+	(
+		const FEMTree< Dim , Real > &tree ,
+		typename FEMIntegrator::template PointEvaluator< IsotropicUIntPack< Dim , DataSig > , ZeroUIntPack< Dim > > *pointEvaluator ,
+		const DensityEstimator< WeightDegree > *densityWeights ,
+		const SparseNodeData< ProjectiveData< Data , Real > , IsotropicUIntPack< Dim , DataSig > > *data ,
+		ConstPointSupportKey< IsotropicUIntPack< Dim , WeightDegree > > &weightKey ,
+		ConstPointSupportKey< IsotropicUIntPack< Dim , FEMSignature< DataSig >::Degree > > &dataKey ,
+		const TreeNode *node ,
+		Point< Real , Dim > center ,
+		Vertex *vertices ,
+		unsigned int vertexCount ,
+		const Data &zeroData
+	)
+	{
+		static const unsigned int DataDegree = FEMSignature< DataSig >::Degree;
+		static const unsigned int MaxVertexCount = 4;
+		if( vertexCount>MaxVertexCount ) ERROR_OUT( "Too many vertices: " , vertexCount , " > " , MaxVertexCount );
+		if( !vertexCount ) return;
+
+		Point< Real , Dim > positions[ MaxVertexCount ];
+		Real depths[ MaxVertexCount ] , weights[ MaxVertexCount ];
+		for( unsigned int i=0 ; i<vertexCount ; i++ ) positions[i] = vertices[i].template get<0>() , depths[i] = (Real)1.;
+		if( densityWeights ) tree._getSampleDepthsAndWeights( *densityWeights , node , positions , vertexCount , weightKey , depths , weights );
+		for( unsigned int i=0 ; i<vertexCount ; i++ ) vertices[i].template get<2>() = depths[i];
+
 		if constexpr( HasData ) if( data )
 		{
+			typedef SparseNodeData< ProjectiveData< Data , Real > , IsotropicUIntPack< Dim , DataSig > > DataCoefficients;
 			if( DataDegree==0 ) 
 			{
-				Point< Real , 3 > center( s[0] + w/2 , s[1] + w/2 , (bCoordinate+fCoordinate)/2 );
+				// The data is evaluated at the center of the leaf so it is the same for all the vertices
 				ProjectiveData< Data , Real > pValue( zeroData );
-				tree.template _addEvaluation< ProjectiveData< Data , Real > , SparseNodeData< ProjectiveData< Data , Real > , IsotropicUIntPack< Dim , DataSig > > , 0 >( *data , center , *pointEvaluator , dataKey , pValue );
-				dataValue = pValue.weight ? pValue.value() : zeroData;
+				tree.template _addEvaluation< ProjectiveData< Data , Real > , DataCoefficients , 0 >( *data , center , *pointEvaluator , dataKey , pValue );
+				Data dataValue = pValue.weight ? pValue.value() : zeroData;
+				for( unsigned int i=0 ; i<vertexCount ; i++ ) vertices[i].template get<3>() = dataValue;
 			}
 			else
 			{
-				ProjectiveData< Data , Real > pValue( zeroData );
-				tree.template _addEvaluation< ProjectiveData< Data , Real > , SparseNodeData< ProjectiveData< Data , Real > , IsotropicUIntPack< Dim , DataSig > > , 0 >( *data , position , *pointEvaluator , dataKey , pValue );
-				dataValue = pValue.weight ? pValue.value() : zeroData;
+				ProjectiveData< Data , Real > pValues[ MaxVertexCount ];
+				for( unsigned int i=0 ; i<vertexCount ; i++ ) pValues[i] = ProjectiveData< Data , Real >( zeroData );
+				tree.template _addEvaluations< ProjectiveData< Data , Real > , DataCoefficients , 0 >( *data , positions , vertexCount , tree._globalToLocal( dataKey.depth() ) , *pointEvaluator , dataKey , pValues );
+				for( unsigned int i=0 ; i<vertexCount ; i++ ) vertices[i].template get<3>() = pValues[i].weight ? pValues[i].value() : zeroData;
 			}
 		}
-		vertex.template get<0>() = position;
-		vertex.template get<1>() = gradient;
-		vertex.template get<2>() = depth;
-		if constexpr( HasData ) vertex.template get<3>() = dataValue;
-		return true;
 	}
 
 	static unsigned int AddIsoPolygons( unsigned int thread , OutputDataStream< Vertex > &vertexStream , OutputDataStream< std::vector< node_index_type > > &polygonStream , std::vector< std::pair< node_index_type , Vertex > >& polygon , bool polygonMesh , bool addBarycenter , node_index_type &vOffset )
@@ -1852,17 +1920,107 @@ public:
 	{
 		double cornersTime , verticesTime , edgesTime , surfaceTime;
 		double setTableTime;
-		Stats( void ) : cornersTime(0) , verticesTime(0) , edgesTime(0) , surfaceTime(0) , setTableTime(0) {;}
+		size_t cornerNodes;
+		Stats( void ) : cornersTime(0) , verticesTime(0) , edgesTime(0) , surfaceTime(0) , setTableTime(0) , cornerNodes(0) {;}
+		Stats &operator += ( const Stats &stats )
+		{
+			cornersTime += stats.cornersTime , verticesTime += stats.verticesTime , edgesTime += stats.edgesTime , surfaceTime += stats.surfaceTime;
+			setTableTime += stats.setTableTime;
+			cornerNodes += stats.cornerNodes;
+			return *this;
+		}
 		std::string toString( void ) const
 		{
 			std::stringstream stream;
 			stream << "Corners / Vertices / Edges / Surface / Set Table: ";
 			stream << std::fixed << std::setprecision(1) << cornersTime << " / " << verticesTime << " / " << edgesTime << " / " << surfaceTime << " / " << setTableTime;
 			stream << " (s)";
+			if( cornerNodes ) stream << ", Corners per million nodes: " << std::setprecision(3) << cornersTime * 1e6 / cornerNodes << " (s)";
 			return stream.str();
 		}
 	};
 
+	// The coarse coefficients, up-sampled to the depths at which they are evaluated, and the evaluators.
+	// These do not depend on the iso-value or on the extracted region so they can be shared by repeated extractions.
+	template< unsigned int ... FEMSigs >
+	struct State
+	{
+		DenseNodeData< Real , UIntPack< FEMSigs ... > > coarseCoefficients;
+		std::vector< _Evaluator< UIntPack< FEMSigs ... > , 1 > > evaluators;
+
+		// Up-samples all of the coarse coefficients
+		State( const FEMTree< Dim , Real > &tree , const DenseNodeData< Real , UIntPack< FEMSigs ... > > &coefficients ) : State( tree , coefficients , 0 , 1<<tree._maxDepth , tree._maxDepth ){}
+
+		// Only up-samples the coarse coefficients whose support can reach the slabs [slabStart,slabEnd) at depth maxDepth (no smaller than the depth of the tree).
+		// At each depth this is the range of slices covering the slabs, padded by the B-spline support,
+		// together with the (padded) parents of the range needed at the next finer depth.
+		// [NOTE] Entries outside of these ranges are never read, so they are not initialized.
+		State( const FEMTree< Dim , Real > &tree , const DenseNodeData< Real , UIntPack< FEMSigs ... > > &coefficients , unsigned int slabStartAtMaxDepth , unsigned int slabEndAtMaxDepth , unsigned int maxDepth ) : coarseCoefficients( tree._sNodesEnd( tree._maxDepth-1 ) )
+		{
+			static const int SupportSizes[] = { BSplineSupportSizes< FEMSignature< FEMSigs >::Degree >::SupportSize ... };
+			int pad = 1;
+			for( unsigned int d=0 ; d<Dim ; d++ ) pad = std::max< int >( pad , SupportSizes[d]+1 );
+
+			// The [start,end) range of node indices that need coarse coefficients, at each depth
+			std::vector< std::pair< node_index_type , node_index_type > > nodeRanges( std::max< LocalDepth >( tree._maxDepth , 0 ) );
+			int sliceStart = 0 , sliceEnd = 0;
+			for( LocalDepth d=tree._maxDepth-1 ; d>=0 ; d-- )
+			{
+				unsigned int dOff = maxDepth - d;
+				int _sliceStart = (int)( slabStartAtMaxDepth>>dOff ) - pad , _sliceEnd = (int)( ( slabEndAtMaxDepth-1 )>>dOff ) + 1 + pad;
+				if( d<tree._maxDepth-1 ) _sliceStart = std::min< int >( _sliceStart , ( sliceStart>>1 ) - pad ) , _sliceEnd = std::max< int >( _sliceEnd , ( (sliceEnd-1)>>1 ) + 1 + pad );
+				sliceStart = _sliceStart , sliceEnd = _sliceEnd;
+				nodeRanges[d] = std::pair< node_index_type , node_index_type >( tree._sNodesBegin( d , sliceStart ) , tree._sNodesEnd( d , sliceEnd-1 ) );
+			}
+
+			for( LocalDepth d=0 ; d<tree._maxDepth ; d++ ) ThreadPool::Parallel_for( nodeRanges[d].first , nodeRanges[d].second , [&]( unsigned int, size_t i ){ coarseCoefficients[i] = coefficients[i]; } );
+			typename FEMIntegrator::template RestrictionProlongation< UIntPack< FEMSigs ... > > rp;
+			for( LocalDepth d=1 ; d<tree._maxDepth ; d++ ) tree._upSample( UIntPack< FEMSigs ... >() , rp , d , ( ConstPointer(Real) )coarseCoefficients()+tree._sNodesBegin(d-1) , coarseCoefficients()+tree._sNodesBegin(d) , nodeRanges[d].first , nodeRanges[d].second );
+
+			evaluators.resize( tree._maxDepth+1 );
+			for( LocalDepth d=0 ; d<=tree._maxDepth ; d++ ) evaluators[d].set( tree._maxDepth );
+		}
+	};
+
+	// Restricts the extraction to a region by clearing the space flags of the nodes that do not overlap the region in the first Dim-1 dimensions,
+	// so that the boundary of the region is treated as the boundary of the space. The last dimension is restricted by the slabs.
+	// Only the nodes at depths [regionDepth,maxDepth] in (and adjacent to) the slabs [slabStart,slabEnd) are touched and their flags are restored on destruction.
+	// [NOTE] This assumes that no leaf straddles the boundary of the region, i.e. that the tree is complete to the depth of the region.
+	struct _RegionMask
+	{
+		_RegionMask( const FEMTree< Dim , Real > &tree , LocalDepth regionDepth , LocalOffset regionStart , LocalOffset regionEnd , unsigned int slabStartAtMaxDepth , unsigned int slabEndAtMaxDepth , unsigned int maxDepth )
+		{
+			bool isRestricted = false;
+			for( unsigned int d=0 ; d<Dim-1 ; d++ ) if( regionStart[d]>0 || regionEnd[d]<(1<<regionDepth) ) isRestricted = true;
+			if( !isRestricted ) return;
+
+			std::vector< std::vector< TreeNode * > > nodes( ThreadPool::NumThreads() );
+			for( LocalDepth depth=regionDepth ; depth<=tree._maxDepth ; depth++ )
+			{
+				unsigned int dOff = maxDepth - depth;
+				int sliceStart = std::max< int >( (int)( slabStartAtMaxDepth>>dOff ) - 1 , 0 ) , sliceEnd = std::min< int >( (int)( ( slabEndAtMaxDepth-1 )>>dOff ) + 2 , 1<<depth );
+				ThreadPool::Parallel_for( tree._sNodesBegin( depth , sliceStart ) , tree._sNodesEnd( depth , sliceEnd-1 ) , [&]( unsigned int thread , size_t i )
+					{
+						TreeNode *node = tree._sNodes.treeNodes[i];
+						if( !tree._isValidSpaceNode( node ) ) return;
+						LocalDepth d ; LocalOffset off;
+						tree._localDepthAndOffset( node , d , off );
+						for( unsigned int dd=0 ; dd<Dim-1 ; dd++ ) if( off[dd]<( regionStart[dd]<<(d-regionDepth) ) || off[dd]>=( regionEnd[dd]<<(d-regionDepth) ) )
+						{
+							node->nodeData.flags &= ~FEMTreeNodeData::SPACE_FLAG;
+							nodes[thread].push_back( node );
+							break;
+						}
+					}
+				);
+			}
+			for( unsigned int t=0 ; t<nodes.size() ; t++ ) _nodes.insert( _nodes.end() , nodes[t].begin() , nodes[t].end() );
+		}
+		~_RegionMask( void ){ for( size_t i=0 ; i<_nodes.size() ; i++ ) _nodes[i]->nodeData.flags |= FEMTreeNodeData::SPACE_FLAG; }
+	protected:
+		std::vector< TreeNode * > _nodes;
+	};
+
 
 	template< unsigned int WeightDegree , unsigned int DataSig , unsigned int ... FEMSigs >
 	static Stats Extract
@@ -1894,15 +2052,111 @@ public:
 		bool copyTopology
 	)
 	{
-		if( maxKeyDepth<tree._maxDepth ) ERROR_OUT( "Max key depth has to be at least tree depth: " , tree._maxDepth , " <= " , maxKeyDepth );
 		if( slabStart>=slabEnd ) ERROR_OUT( "Slab start cannot excceed slab end: " , slabStart , " < " , slabEnd );
 		if( slabEnd>(1u<<slabDepth) ) ERROR_OUT( "Slab end cannot exceed slab num: " , slabEnd , " <= " , 1<<slabDepth );
 
-		LevelSetExtraction::KeyGenerator< Dim > keyGenerator( maxKeyDepth );
 		LocalOffset start , end;
 		for( unsigned int d=0 ; d<Dim-1 ; d++ ) start[d] = 0 , end[d] = (1<<slabDepth);
 		start[Dim-1] = slabStart  , end[Dim-1] = slabEnd;
-		LocalDepth fullDepth = tree.getFullDepth( UIntPack< FEMSignature< FEMSigs >::Degree ... >() , slabDepth , start , end );
+		unsigned int maxDepth = std::max< unsigned int >( tree._maxDepth , slabDepth );
+		State< FEMSigs ... > state( tree , coefficients , slabStart << ( maxDepth - slabDepth ) , slabEnd << ( maxDepth - slabDepth ) , maxDepth );
+		node_index_type vertexOffset = 0;
+		return _Extract< WeightDegree , DataSig , FEMSigs ... >( UIntPack< FEMSigs ... >() , UIntPack< WeightDegree >() , UIntPack< DataSig >() , tree , maxKeyDepth , densityWeights , data , coefficients , state , isoValue , slabDepth , start , end , vertexOffset , vertexStream , polygonStream , zeroData , nonLinearFit , gradientNormals , addBarycenter , polygonMesh , flipOrientation , backBoundary , frontBoundary , backDValues , frontDValues , copyTopology );
+	}
+
+	// Extracts the level-sets at the iso-values, restricted to the box [regionMin,regionMax] in the unit cube, using the shared state.
+	// The box is expanded to the cells at depth regionDepth containing it, coarsened (if necessary) until the tree is complete to that depth over the box, so that no leaf straddles its boundary.
+	// The returned level-sets are open along the boundary of the expanded box and the vertex indices are relative to the first vertex written.
+	template< unsigned int WeightDegree , unsigned int DataSig , unsigned int ... FEMSigs >
+	static Stats ExtractRegion
+	(
+		UIntPack< FEMSigs ... > ,
+		UIntPack< WeightDegree > ,
+		UIntPack< DataSig > ,
+		const FEMTree< Dim , Real > &tree ,
+		const DensityEstimator< WeightDegree > *densityWeights ,
+		const SparseNodeData< ProjectiveData< Data , Real > , IsotropicUIntPack< Dim , DataSig > > *data ,
+		const DenseNodeData< Real , UIntPack< FEMSigs ... > > &coefficients ,
+		const State< FEMSigs ... > &state ,
+		const std::vector< Real > &isoValues ,
+		Point< Real , Dim > regionMin ,
+		Point< Real , Dim > regionMax ,
+		unsigned int regionDepth ,
+		OutputDataStream< Vertex > &vertexStream ,
+		OutputDataStream< std::vector< node_index_type > > &polygonStream ,
+		const Data &zeroData ,
+		bool nonLinearFit ,
+		bool gradientNormals ,
+		bool addBarycenter ,
+		bool polygonMesh ,
+		bool flipOrientation
+	)
+	{
+		LocalOffset start , end;
+		auto SetRegion = [&]( void )
+		{
+			int res = 1<<regionDepth;
+			for( unsigned int d=0 ; d<Dim ; d++ )
+			{
+				start[d] = std::max< int >( (int)floor( regionMin[d] * res ) , 0 );
+				end[d] = std::min< int >( (int)ceil( regionMax[d] * res ) , res );
+				if( end[d]<=start[d] ) ERROR_OUT( "Empty region: [ " , regionMin , " , " , regionMax , " ]" );
+			}
+		};
+		regionDepth = std::min< unsigned int >( regionDepth , tree._maxDepth );
+		SetRegion();
+		LocalDepth fullDepth;
+		while( ( fullDepth=tree.getFullDepth( UIntPack< FEMSignature< FEMSigs >::Degree ... >() , regionDepth , start , end ) )<(LocalDepth)regionDepth )
+		{
+			regionDepth = (unsigned int)std::max< LocalDepth >( fullDepth , 0 );
+			SetRegion();
+		}
+
+		Stats stats;
+		node_index_type vertexOffset = 0;
+		std::vector< std::vector< Real > > dValues;
+		for( size_t i=0 ; i<isoValues.size() ; i++ )
+			stats += _Extract< WeightDegree , DataSig , FEMSigs ... >( UIntPack< FEMSigs ... >() , UIntPack< WeightDegree >() , UIntPack< DataSig >() , tree , tree._maxDepth , densityWeights , data , coefficients , state , isoValues[i] , regionDepth , start , end , vertexOffset , vertexStream , polygonStream , zeroData , nonLinearFit , gradientNormals , addBarycenter , polygonMesh , flipOrientation , NULL , NULL , dValues , dValues , false );
+		return stats;
+	}
+
+	template< unsigned int WeightDegree , unsigned int DataSig , unsigned int ... FEMSigs >
+	static Stats _Extract
+	(
+		UIntPack< FEMSigs ... > ,
+		UIntPack< WeightDegree > ,
+		UIntPack< DataSig > ,
+		const FEMTree< Dim , Real > &tree ,
+		int maxKeyDepth ,
+		const DensityEstimator< WeightDegree > *densityWeights ,
+		const SparseNodeData< ProjectiveData< Data , Real > , IsotropicUIntPack< Dim , DataSig > > *data ,
+		const DenseNodeData< Real , UIntPack< FEMSigs ... > > &coefficients ,
+		const State< FEMSigs ... > &state ,
+		Real isoValue ,
+		unsigned int slabDepth ,
+		LocalOffset regionStart ,
+		LocalOffset regionEnd ,
+		node_index_type &vertexOffset ,
+		OutputDataStream< Vertex > &vertexStream ,
+		OutputDataStream< std::vector< node_index_type > > &polygonStream ,
+		const Data &zeroData ,
+		bool nonLinearFit ,
+		bool gradientNormals ,
+		bool addBarycenter ,
+		bool polygonMesh ,
+		bool flipOrientation ,
+		const typename LevelSetExtractor< Real , Dim-1 , Point< Real , Dim-1 > >::TreeSliceValuesAndVertexPositions * backBoundary ,
+		const typename LevelSetExtractor< Real , Dim-1 , Point< Real , Dim-1 > >::TreeSliceValuesAndVertexPositions *frontBoundary ,
+		const std::vector< std::vector< Real > > &backDValues ,
+		const std::vector< std::vector< Real > > &frontDValues ,
+		bool copyTopology
+	)
+	{
+		unsigned int slabStart = regionStart[Dim-1] , slabEnd = regionEnd[Dim-1];
+		if( maxKeyDepth<tree._maxDepth ) ERROR_OUT( "Max key depth has to be at least tree depth: " , tree._maxDepth , " <= " , maxKeyDepth );
+
+		LevelSetExtraction::KeyGenerator< Dim > keyGenerator( maxKeyDepth );
+		LocalDepth fullDepth = tree.getFullDepth( UIntPack< FEMSignature< FEMSigs >::Degree ... >() , slabDepth , regionStart , regionEnd );
 		unsigned int maxDepth = std::max< unsigned int >( tree._maxDepth , slabDepth );
 		unsigned int slabStartAtMaxDepth = slabStart << ( maxDepth - slabDepth );
 		unsigned int slabEndAtMaxDepth = slabEnd << ( maxDepth - slabDepth );
@@ -1923,16 +2177,11 @@ public:
 
 		typename FEMIntegrator::template PointEvaluator< IsotropicUIntPack< Dim , DataSig > , ZeroUIntPack< Dim > >* pointEvaluator = NULL;
 		if constexpr( HasData ) if( data ) pointEvaluator = new typename FEMIntegrator::template PointEvaluator< IsotropicUIntPack< Dim , DataSig > , ZeroUIntPack< Dim > >( tree._maxDepth );
-		DenseNodeData< Real , UIntPack< FEMSigs ... > > coarseCoefficients( tree._sNodesEnd( tree._maxDepth-1 ) );
-		memset( coarseCoefficients() , 0 , sizeof(Real)*tree._sNodesEnd( tree._maxDepth-1 ) );
-		ThreadPool::Parallel_for( tree._sNodesBegin(0) , tree._sNodesEnd( tree._maxDepth-1 ) , [&]( unsigned int, size_t i ){ coarseCoefficients[i] = coefficients[i]; } );
-		typename FEMIntegrator::template RestrictionProlongation< UIntPack< FEMSigs ... > > rp;
-		for( LocalDepth d=1 ; d<tree._maxDepth ; d++ ) tree._upSample( UIntPack< FEMSigs ... >() , rp , d , ( ConstPointer(Real) )coarseCoefficients()+tree._sNodesBegin(d-1) , coarseCoefficients()+tree._sNodesBegin(d) );
 
-		std::vector< _Evaluator< UIntPack< FEMSigs ... > , 1 > > evaluators( tree._maxDepth+1 );
-		for( LocalDepth d=0 ; d<=tree._maxDepth ; d++ ) evaluators[d].set( tree._maxDepth );
+		const DenseNodeData< Real , UIntPack< FEMSigs ... > > &coarseCoefficients = state.coarseCoefficients;
+		const std::vector< _Evaluator< UIntPack< FEMSigs ... > , 1 > > &evaluators = state.evaluators;
 
-		node_index_type vertexOffset = 0;
+		_RegionMask regionMask( tree , slabDepth , regionStart , regionEnd , slabStartAtMaxDepth , slabEndAtMaxDepth , maxDepth );
 
 		std::vector< SlabValues > slabValues( tree._maxDepth+1 );
 		std::vector< std::pair< node_index_type , node_index_type > > backIncidence , frontIncidence;
@@ -2024,6 +2273,10 @@ public:
 			}
 		};
 
+		// Merging the per-thread scratch into the maps is done once per slice/slab, for all depths at once.
+		// Each task writes into the maps of a single (X)SliceValues so the tasks can run concurrently.
+		std::vector< std::function< void ( void ) > > finalizeTasks;
+
 		auto FinalizeSlice = [&]( unsigned int sliceAtMaxDepth )
 		{
 
@@ -2035,12 +2288,9 @@ public:
 				{
 					if( d<=tree._maxDepth )
 					{
-						ThreadPool::ParallelSections
-						(
-							[ &slabValues , d , o ]( void ){ slabValues[d].sliceValues(o).setFromScratch( slabValues[d].sliceScratch(o).vKeyValues ); } ,
-							[ &slabValues , d , o ]( void ){ slabValues[d].sliceValues(o).setFromScratch( slabValues[d].sliceScratch(o).eKeyValues ); } ,
-							[ &slabValues , d , o ]( void ){ slabValues[d].sliceValues(o).setFromScratch( slabValues[d].sliceScratch(o).fKeyValues ); }
-						);
+						finalizeTasks.push_back( [ &slabValues , d , o ]( void ){ slabValues[d].sliceValues(o).setFromScratch( slabValues[d].sliceScratch(o).vKeyValues ); } );
+						finalizeTasks.push_back( [ &slabValues , d , o ]( void ){ slabValues[d].sliceValues(o).setFromScratch( slabValues[d].sliceScratch(o).eKeyValues ); } );
+						finalizeTasks.push_back( [ &slabValues , d , o ]( void ){ slabValues[d].sliceValues(o).setFromScratch( slabValues[d].sliceScratch(o).fKeyValues ); } );
 					}
 					if( o&1 ) break;
 				}
@@ -2055,17 +2305,20 @@ public:
 			{
 				if( d<=tree._maxDepth )
 				{
-					ThreadPool::ParallelSections
-					(
-						[ &slabValues , d , o ]( void ){ slabValues[d].xSliceValues(o).setFromScratch( slabValues[d].xSliceScratch(o).vKeyValues ); } ,
-						[ &slabValues , d , o ]( void ){ slabValues[d].xSliceValues(o).setFromScratch( slabValues[d].xSliceScratch(o).eKeyValues ); } ,
-						[ &slabValues , d , o ]( void ){ slabValues[d].xSliceValues(o).setFromScratch( slabValues[d].xSliceScratch(o).fKeyValues ); }
-					);
+					finalizeTasks.push_back( [ &slabValues , d , o ]( void ){ slabValues[d].xSliceValues(o).setFromScratch( slabValues[d].xSliceScratch(o).vKeyValues ); } );
+					finalizeTasks.push_back( [ &slabValues , d , o ]( void ){ slabValues[d].xSliceValues(o).setFromScratch( slabValues[d].xSliceScratch(o).eKeyValues ); } );
+					finalizeTasks.push_back( [ &slabValues , d , o ]( void ){ slabValues[d].xSliceValues(o).setFromScratch( slabValues[d].xSliceScratch(o).fKeyValues ); } );
 				}
 				if( !(o&1) && !boundary ) break;
 			}
 		};
 
+		auto Finalize = [&]( void )
+		{
+			ThreadPool::Parallel_for( 0 , finalizeTasks.size() , [&]( unsigned int , size_t i ){ finalizeTasks[i](); } , ThreadPool::DYNAMIC , 1 );
+			finalizeTasks.clear();
+		};
+
 		auto SetSliceValues = [&]( unsigned int sliceAtMaxDepth )
 		{
 
@@ -2105,7 +2358,7 @@ public:
 								SetMCIndices( tree , isoValue , d , fullDepth , o , slabValues );
 							}
 						}
-						else SetSliceCornerValuesAndMCIndices< FEMSigs ... >( tree , coefficients() , coarseCoefficients() , isoValue , d , fullDepth , o , slabValues , evaluators[d] );				
+						else stats.cornerNodes += SetSliceCornerValuesAndMCIndices< FEMSigs ... >( tree , coefficients() , coarseCoefficients() , isoValue , d , fullDepth , o , slabValues , evaluators[d] );
 					}
 					if( o&1 ) break;
 				}
@@ -2257,6 +2510,7 @@ public:
 		SetSliceValues( slabStartAtMaxDepth );
 		SetSliceIso( slabStartAtMaxDepth );
 		FinalizeSlice( slabStartAtMaxDepth );
+		Finalize();
 
 		// Iterate over the slabs at the finest level
 		for( unsigned int slab=slabStartAtMaxDepth ; slab<slabEndAtMaxDepth ; slab++)
@@ -2277,6 +2531,7 @@ public:
 
 			FinalizeSlice( slab+1 );
 			FinalizeSlab( slab );
+			Finalize();
 
 			IsoSurface( slab );
 		}
@@ -2301,6 +2556,7 @@ struct LevelSetExtractor< Real , 3 >
 	typedef typename _LevelSetExtractor< HasData , Real , Dim , Data >::Vertex Vertex;
 	typedef typename _LevelSetExtractor< HasData , Real , Dim , Data >::TreeNode TreeNode;
 	template< unsigned int WeightDegree > using DensityEstimator = typename _LevelSetExtractor< HasData , Real , Dim , Data >::template DensityEstimator< WeightDegree >;
+	template< unsigned int ... FEMSigs > using State = typename _LevelSetExtractor< HasData , Real , Dim , Data >::template State< FEMSigs ... >;
 
 	template< unsigned int WeightDegree , unsigned int ... FEMSigs >
 	static Stats Extract( UIntPack< FEMSigs ... > , UIntPack< WeightDegree > , const FEMTree< Dim , Real >& tree , const DensityEstimator< WeightDegree > *densityWeights , const DenseNodeData< Real , UIntPack< FEMSigs ... > > &coefficients , Real isoValue , OutputDataStream< Vertex > &vertexStream , OutputDataStream< std::vector< node_index_type > > &polygonStream , bool nonLinearFit , bool outputGradients , bool addBarycenter , bool polygonMesh , bool flipOrientation )
@@ -2323,6 +2579,16 @@ struct LevelSetExtractor< Real , 3 >
 		Data zeroData = 0;
 		return _LevelSetExtractor< HasData , Real , Dim , Data >::template Extract< WeightDegree , DataSig , FEMSigs ... >( UIntPack< FEMSigs ... >() , UIntPack< WeightDegree >() , UIntPack< DataSig >() , tree , maxKeyDepth , densityWeights , data , coefficients , isoValue , slabDepth , slabStart , slabEnd , vertexStream , polygonStream , zeroData , nonLinearFit , outputGradients , addBarycenter , polygonMesh , flipOrientation , backBoundary , frontBoundary , backDValues , frontDValues , copyTopology );
 	}
+
+	// Extracts the level-sets at the iso-values within the box [regionMin,regionMax] of the unit cube, sharing the state across calls
+	template< unsigned int WeightDegree , unsigned int ... FEMSigs >
+	static Stats ExtractRegion( UIntPack< FEMSigs ... > , UIntPack< WeightDegree > , const FEMTree< Dim , Real >& tree , const DensityEstimator< WeightDegree >* densityWeights , const DenseNodeData< Real , UIntPack< FEMSigs ... > >& coefficients , const State< FEMSigs ... > &state , const std::vector< Real > &isoValues , Point< Real , Dim > regionMin , Point< Real , Dim > regionMax , unsigned int regionDepth , OutputDataStream< Vertex > &vertexStream , OutputDataStream< std::vector< node_index_type > > &polygonStream , bool nonLinearFit , bool outputGradients , bool addBarycenter , bool polygonMesh , bool flipOrientation )
+	{
+		static const unsigned int DataSig = FEMDegreeAndBType< 0 , BOUNDARY_FREE >::Signature;
+		const SparseNodeData< ProjectiveData< Data , Real > , IsotropicUIntPack< Dim , DataSig > > *data = NULL;
+		Data zeroData = 0;
+		return _LevelSetExtractor< HasData , Real , Dim , Data >::template ExtractRegion< WeightDegree , DataSig , FEMSigs ... >( UIntPack< FEMSigs ... >() , UIntPack< WeightDegree >() , UIntPack< DataSig >() , tree , densityWeights , data , coefficients , state , isoValues , regionMin , regionMax , regionDepth , vertexStream , polygonStream , zeroData , nonLinearFit , outputGradients , addBarycenter , polygonMesh , flipOrientation );
+	}
 };
 
 template< typename Real , typename Data >
@@ -2334,6 +2600,7 @@ struct LevelSetExtractor< Real , 3 , Data >
 	typedef typename _LevelSetExtractor< HasData , Real , Dim , Data >::Vertex Vertex;
 	typedef typename _LevelSetExtractor< HasData , Real , Dim , Data >::TreeNode TreeNode;
 	template< unsigned int WeightDegree > using DensityEstimator = typename _LevelSetExtractor< HasData , Real , Dim , Data >::template DensityEstimator< WeightDegree >;
+	template< unsigned int ... FEMSigs > using State = typename _LevelSetExtractor< HasData , Real , Dim , Data >::template State< FEMSigs ... >;
 
 	template< unsigned int WeightDegree , unsigned int DataSig , unsigned int ... FEMSigs >
 	static Stats Extract( UIntPack< FEMSigs ... > , UIntPack< WeightDegree > , UIntPack< DataSig > , const FEMTree< Dim , Real >& tree , const DensityEstimator< WeightDegree > *densityWeights , const SparseNodeData< ProjectiveData< Data , Real > , IsotropicUIntPack< Dim , DataSig > > *data , const DenseNodeData< Real , UIntPack< FEMSigs ... > > &coefficients , Real isoValue , OutputDataStream< Vertex > &vertexStream , OutputDataStream< std::vector< node_index_type > > &polygonStream , const Data &zeroData , bool nonLinearFit , bool outputGradients , bool addBarycenter , bool polygonMesh , bool flipOrientation )
@@ -2353,4 +2620,11 @@ struct LevelSetExtractor< Real , 3 , Data >
 	{
 		return _LevelSetExtractor< HasData , Real , Dim , Data >::template Extract< WeightDegree , DataSig , FEMSigs ... >( UIntPack< FEMSigs ... >() , UIntPack< WeightDegree >() , UIntPack< DataSig >() , tree , maxKeyDepth , densityWeights , data , coefficients , isoValue , slabDepth , slabStart , slabEnd , vertexStream , polygonStream , zeroData , nonLinearFit , outputGradients , addBarycenter , polygonMesh , flipOrientation , backBoundary , frontBoundary , backDValues , frontDValues , copyTopology );
 	}
+
+	// Extracts the level-sets at the iso-values within the box [regionMin,regionMax] of the unit cube, sharing the state across calls
+	template< unsigned int WeightDegree , unsigned int DataSig , unsigned int ... FEMSigs >
+	static Stats ExtractRegion( UIntPack< FEMSigs ... > , UIntPack< WeightDegree > , UIntPack< DataSig > , const FEMTree< Dim , Real >& tree , const DensityEstimator< WeightDegree >* densityWeights , const SparseNodeData< ProjectiveData< Data , Real > , IsotropicUIntPack< Dim , DataSig > >* data , const DenseNodeData< Real , UIntPack< FEMSigs ... > >& coefficients , const State< FEMSigs ... > &state , const std::vector< Real > &isoValues , Point< Real , Dim > regionMin , Point< Real , Dim > regionMax , unsigned int regionDepth , OutputDataStream< Vertex > &vertexStream , OutputDataStream< std::vector< node_index_type > > &polygonStream , const Data &zeroData , bool nonLinearFit , bool outputGradients , bool addBarycenter , bool polygonMesh , bool flipOrientation )
+	{
+		return _LevelSetExtractor< HasData , Real , Dim , Data >::template ExtractRegion< WeightDegree , DataSig , FEMSigs ... >( UIntPack< FEMSigs ... >() , UIntPack< WeightDegree >() , UIntPack< DataSig >() , tree , densityWeights , data , coefficients , state , isoValues , regionMin , regionMax , regionDepth , vertexStream , polygonStream , zeroData , nonLinearFit , outputGradients , addBarycenter , polygonMesh , flipOrientation );
+	}
 };
@@ -69,21 +69,140 @@ namespace LevelSetExtraction
 
 		friend std::ostream &operator << ( std::ostream &os , const Key &key ){ return os << key.to_string(); }
 
-#ifdef SHOW_WARNINGS
-#pragma message( "[WARNING] Could we hash better?" )
-#endif // SHOW_WARNINGS
+		// [NOTE] The bits need to be well mixed since the key maps use the low bits of the hash to index into the table
 		struct Hasher
 		{
 			size_t operator()( const Key &i ) const
 			{
-				size_t hash = 0;
-				for( unsigned int d=0 ; d<Dim ; d++ ) hash ^= i.idx[d];
-				return hash;
+				unsigned long long hash = 0;
+				for( unsigned int d=0 ; d<Dim ; d++ ) hash = ( hash ^ i.idx[d] ) * 0x9E3779B97F4A7C15ULL;
+				return (size_t)( hash ^ ( hash>>32 ) );
 			}
 		};
 	};
 
-	template< unsigned int Dim , typename Data > using KeyMap = std::unordered_map< Key< Dim > , Data , typename Key< Dim >::Hasher >;
+	////////////
+	// KeyMap //
+	////////////
+	// A flat hash table using open addressing (with linear probing) that is never more than half full.
+	// The interface is the subset of std::unordered_map used by the level-set extraction code.
+	template< unsigned int Dim , typename Data >
+	struct KeyMap
+	{
+		typedef std::pair< Key< Dim > , Data > value_type;
+
+		template< bool Const >
+		struct _iterator
+		{
+			using Map = typename std::conditional< Const , const KeyMap , KeyMap >::type;
+			using Value = typename std::conditional< Const , const value_type , value_type >::type;
+
+			_iterator( void ) : _map(NULL) , _idx(0) {}
+			_iterator( Map *map , size_t idx ) : _map(map) , _idx(idx) { _advance(); }
+			template< bool _Const , typename = typename std::enable_if< Const && !_Const >::type >
+			_iterator( const _iterator< _Const > &iter ) : _map(iter._map) , _idx(iter._idx) {}
+
+			Value &operator * ( void ) const { return _map->_slots[_idx]; }
+			Value *operator -> ( void ) const { return &_map->_slots[_idx]; }
+			_iterator &operator ++ ( void ){ _idx++ ; _advance() ; return *this; }
+			_iterator operator ++ ( int ){ _iterator iter = *this ; ++(*this) ; return iter; }
+			bool operator == ( const _iterator &iter ) const { return _idx==iter._idx; }
+			bool operator != ( const _iterator &iter ) const { return _idx!=iter._idx; }
+		protected:
+			template< bool > friend struct _iterator;
+			Map *_map;
+			size_t _idx;
+			void _advance( void ){ while( _idx<_map->_slots.size() && !_map->_occupied[_idx] ) _idx++; }
+		};
+		typedef _iterator< false > iterator;
+		typedef _iterator< true > const_iterator;
+
+		KeyMap( void ) : _size(0) {}
+
+		size_t size( void ) const { return _size; }
+		bool empty( void ) const { return _size==0; }
+
+		// Sizes the table so that the specified number of keys can be inserted without re-hashing
+		void reserve( size_t sz )
+		{
+			size_t capacity = 16;
+			while( capacity<2*sz ) capacity <<= 1;
+			if( capacity>_slots.size() ) _rehash( capacity );
+		}
+
+		// Empties the table, retaining its capacity
+		void clear( void )
+		{
+			if( !_size ) return;
+			// [NOTE] The values are re-constructed rather than assigned to, as assignment between dynamically sized values of different sizes is not supported
+			for( size_t i=0 ; i<_slots.size() ; i++ ) if( _occupied[i] )
+			{
+				_slots[i].second.~Data();
+				new( &_slots[i].second ) Data();
+				_occupied[i] = 0;
+			}
+			_size = 0;
+		}
+
+		Data &operator[]( const Key< Dim > &key )
+		{
+			if( 2*(_size+1)>_slots.size() ) reserve( _size+1 );
+			size_t idx = _index( key );
+			if( !_occupied[idx] )
+			{
+				_slots[idx].first = key;
+				_occupied[idx] = 1;
+				_size++;
+			}
+			return _slots[idx].second;
+		}
+
+		iterator find( const Key< Dim > &key )
+		{
+			if( !_size ) return end();
+			size_t idx = _index( key );
+			return _occupied[idx] ? iterator( this , idx ) : end();
+		}
+		const_iterator find( const Key< Dim > &key ) const
+		{
+			if( !_size ) return end();
+			size_t idx = _index( key );
+			return _occupied[idx] ? const_iterator( this , idx ) : end();
+		}
+
+		iterator begin( void ){ return iterator( this , 0 ); }
+		iterator end( void ){ return iterator( this , _slots.size() ); }
+		const_iterator begin( void ) const { return const_iterator( this , 0 ); }
+		const_iterator end( void ) const { return const_iterator( this , _slots.size() ); }
+		const_iterator cbegin( void ) const { return begin(); }
+		const_iterator cend( void ) const { return end(); }
+	protected:
+		std::vector< value_type > _slots;
+		std::vector< unsigned char > _occupied;
+		size_t _size;
+
+		// Returns the slot containing the key or, if the key is not in the table, the empty slot it would be inserted into
+		size_t _index( const Key< Dim > &key ) const
+		{
+			size_t mask = _slots.size()-1;
+			size_t idx = typename Key< Dim >::Hasher()( key ) & mask;
+			while( _occupied[idx] && _slots[idx].first!=key ) idx = ( idx+1 ) & mask;
+			return idx;
+		}
+
+		void _rehash( size_t capacity )
+		{
+			std::vector< value_type > slots( capacity );
+			std::vector< unsigned char > occupied( capacity , 0 );
+			std::swap( slots , _slots ) , std::swap( occupied , _occupied );
+			for( size_t i=0 ; i<slots.size() ; i++ ) if( occupied[i] )
+			{
+				size_t idx = _index( slots[i].first );
+				_slots[idx] = std::move( slots[i] );
+				_occupied[idx] = 1;
+			}
+		}
+	};
 
 	/////////////
 	// IsoEdge //
@@ -498,7 +617,7 @@ namespace LevelSetExtraction
 
 		node_index_type nodeOffset;
 
-		SliceCellIndexData( void ) : nodeOffset(0) {}
+		SliceCellIndexData( void ) : nodeOffset(0) , _neighborKeyDepth(-1) {}
 
 		void read( BinaryStream &stream )
 		{
@@ -519,13 +638,18 @@ namespace LevelSetExtraction
 			resize( (size_t)( span.second - span.first ) );
 			_scratch.resize( size() );
 
-			std::vector< ConstOneRingNeighborKey > neighborKeys( ThreadPool::NumThreads() );
-			for( size_t i=0 ; i<neighborKeys.size() ; i++ ) neighborKeys[i].set( depth );
+			// The neighbor keys are re-used across calls at the same depth
+			if( _neighborKeys.size()!=ThreadPool::NumThreads() || _neighborKeyDepth!=depth )
+			{
+				_neighborKeys.resize( ThreadPool::NumThreads() );
+				for( size_t i=0 ; i<_neighborKeys.size() ; i++ ) _neighborKeys[i].set( depth );
+				_neighborKeyDepth = depth;
+			}
 
 			// Try and get at the nodes outside of the slab through the neighbor key
 			ThreadPool::Parallel_for( sNodes.begin( depth , slice-1 ) , sNodes.end( depth , slice ) , [&]( unsigned int thread , size_t i )
 				{
-					ConstOneRingNeighborKey &neighborKey = neighborKeys[ thread ];
+					ConstOneRingNeighborKey &neighborKey = _neighborKeys[ thread ];
 					const TreeNode *node = sNodes.treeNodes[i];
 					ConstNeighbors &neighbors = neighborKey.getNeighbors( node );
 					_setProcess<0>( neighbors , i<(size_t)sNodes.end( depth , slice-1 ) , _scratch.maps );
@@ -544,6 +668,8 @@ namespace LevelSetExtraction
 
 	protected:
 		_Scratch< _Dim , MaxCellDim > _scratch;
+		std::vector< ConstOneRingNeighborKey > _neighborKeys;
+		int _neighborKeyDepth;
 
 		template< unsigned int CellDim >
 		void _setProcess( const ConstNeighbors& neighbors , bool fromBehind , Pointer( node_index_type ) maps[MaxCellDim+1] )
@@ -632,7 +758,7 @@ namespace LevelSetExtraction
 
 		node_index_type nodeOffset;
 
-		SlabCellIndexData( void ) : nodeOffset(0) {}
+		SlabCellIndexData( void ) : nodeOffset(0) , _neighborKeyDepth(-1) {}
 
 		void read( BinaryStream &stream )
 		{
@@ -653,13 +779,18 @@ namespace LevelSetExtraction
 			resize( (size_t)( span.second - span.first ) );
 			_scratch.resize( size() );
 
-			std::vector< ConstOneRingNeighborKey > neighborKeys( ThreadPool::NumThreads() );
-			for( size_t i=0 ; i<neighborKeys.size() ; i++ ) neighborKeys[i].set( depth );
+			// The neighbor keys are re-used across calls at the same depth
+			if( _neighborKeys.size()!=ThreadPool::NumThreads() || _neighborKeyDepth!=depth )
+			{
+				_neighborKeys.resize( ThreadPool::NumThreads() );
+				for( size_t i=0 ; i<_neighborKeys.size() ; i++ ) _neighborKeys[i].set( depth );
+				_neighborKeyDepth = depth;
+			}
 
 			// Try and get at the nodes outside of the slab through the neighbor key
 			ThreadPool::Parallel_for( sNodes.begin( depth , slab ) , sNodes.end( depth , slab ) , [&]( unsigned int thread , size_t i )
 				{
-					ConstOneRingNeighborKey &neighborKey = neighborKeys[ thread ];
+					ConstOneRingNeighborKey &neighborKey = _neighborKeys[ thread ];
 					const TreeNode *node = sNodes.treeNodes[i];
 					ConstNeighbors &neighbors = neighborKey.getNeighbors( node );
 					_setProcess<0>( neighbors , _scratch.maps );
@@ -678,6 +809,8 @@ namespace LevelSetExtraction
 
 	protected:
 		_Scratch< _Dim , _MaxCellDim > _scratch;
+		std::vector< ConstOneRingNeighborKey > _neighborKeys;
+		int _neighborKeyDepth;
 
 
 		template< unsigned int _CellDim >
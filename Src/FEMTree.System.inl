@@ -194,6 +194,13 @@ void FEMTree< Dim , Real >::setMultiColorIndices( UIntPack< FEMSigs ... > , int
 	_setMultiColorIndices( UIntPack< FEMSigs ... >() , _sNodesBegin(depth) , _sNodesEnd(depth) , indices );
 }
 template< unsigned int Dim , class Real >
+void FEMTree< Dim , Real >::_setSliceBlockStarts( LocalDepth depth , std::vector< size_t > &blockStarts ) const
+{
+	int d = _localToGlobal( depth );
+	blockStarts.resize( 0 );
+	for( int s=0 ; s<(1<<d) ; s++ ) if( _sNodes.size( d , s ) ) blockStarts.push_back( _sNodes.begin( d , s ) - _sNodes.begin( d ) );
+}
+template< unsigned int Dim , class Real >
 template< unsigned int ... FEMSigs >
 void FEMTree< Dim , Real >::_setMultiColorIndices( UIntPack< FEMSigs ... > , node_index_type start , node_index_type end , std::vector< std::vector< size_t > >& indices ) const
 {
@@ -238,7 +245,7 @@ void FEMTree< Dim , Real >::_setMultiColorIndices( UIntPack< FEMSigs ... > , nod
 
 template< unsigned int Dim , class Real >
 template< unsigned int ... FEMSigs , typename T , typename TDotT , typename SORWeights , typename ... InterpolationInfos >
-int FEMTree< Dim , Real >::_solveFullSystemGS( UIntPack< FEMSigs ... > , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , SORWeights sorWeights , _SolverStats& stats , bool computeNorms , std::tuple< InterpolationInfos *... > interpolationInfos ) const
+int FEMTree< Dim , Real >::_solveFullSystemGS( UIntPack< FEMSigs ... > , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , SORWeights sorWeights , _SolverStats& stats , bool computeNorms , double sweepAccuracy , double sweepStagnation , std::tuple< InterpolationInfos *... > interpolationInfos ) const
 {
 	double& systemTime = stats.systemTime;
 	double&  solveTime = stats. solveTime;
@@ -287,7 +294,15 @@ int FEMTree< Dim , Real >::_solveFullSystemGS( UIntPack< FEMSigs ... > , const t
 		}
 
 		t = Time();
-		for( int i=0 ; i<iters ; i++ ) M.gsIteration( mcIndices , ( ConstPointer( Real ) )D , B , X , coarseToFine , true );
+		if( sweepAccuracy>0 || sweepStagnation>0 )
+		{
+			// Use the residuals computed as a by-product of the sweeps to stop as soon as the target is met
+			std::vector< double > sweepRNorm2s;
+			int i;
+			for( i=0 ; i<iters && !_SweepsConverged( sweepRNorm2s , sweepAccuracy , sweepStagnation ) ; i++ ) sweepRNorm2s.push_back( M.gsIteration( mcIndices , ( ConstPointer( Real ) )D , B , X , coarseToFine , true , Dot ) );
+			iters = i;
+		}
+		else for( int i=0 ; i<iters ; i++ ) M.gsIteration( mcIndices , ( ConstPointer( Real ) )D , B , X , coarseToFine , true );
 		FreePointer( D );
 		solveTime += Time() - t;
 
@@ -314,9 +329,9 @@ int FEMTree< Dim , Real >::_solveFullSystemGS( UIntPack< FEMSigs ... > , const t
 }
 template< unsigned int Dim , class Real >
 template< unsigned int ... FEMSigs , typename T , typename TDotT , typename SORWeights , typename ... InterpolationInfos >
-int FEMTree< Dim , Real >::_solveSlicedSystemGS( UIntPack< FEMSigs ... > , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , unsigned int sliceBlockSize , SORWeights sorWeights , _SolverStats& stats , bool computeNorms , std::tuple< InterpolationInfos *... > interpolationInfos ) const
+int FEMTree< Dim , Real >::_solveSlicedSystemGS( UIntPack< FEMSigs ... > , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , unsigned int sliceBlockSize , SORWeights sorWeights , _SolverStats& stats , bool computeNorms , std::vector< double > *sweepRNorm2s , std::tuple< InterpolationInfos *... > interpolationInfos ) const
 {
-	if( sliceBlockSize<=0 ) return _solveFullSystemGS( UIntPack< FEMSigs ... >() , F , bsData , depth , solution , prolongedSolution , constraints , Dot , iters , coarseToFine , sorWeights , stats , computeNorms , interpolationInfos );
+	if( sliceBlockSize<=0 ) return _solveFullSystemGS( UIntPack< FEMSigs ... >() , F , bsData , depth , solution , prolongedSolution , constraints , Dot , iters , coarseToFine , sorWeights , stats , computeNorms , 0. , 0. , interpolationInfos );
 	CCStencil< UIntPack< FEMSignature< FEMSigs >::Degree ... > > ccStencil;
 	PCStencils< UIntPack< FEMSignature< FEMSigs >::Degree ... > > pcStencils;
 	F.template setStencil< false >( ccStencil );
@@ -445,6 +460,8 @@ int FEMTree< Dim , Real >::_solveSlicedSystemGS( UIntPack< FEMSigs ... > , const
 		}
 		if( maxBlockSize>std::numeric_limits< matrix_index_type >::max() ) ERROR_OUT( "more entries in a block than can be indexed in " , sizeof(matrix_index_type) , " bytes" );
 		for( int i=0 ; i<matrixBlocks ; i++ ) _constraints[i] = AllocPointer< T >( maxBlockSize ) , _D[i] = AllocPointer< Real >( maxBlockSize );
+		// The square norms of the residuals computed as a by-product of each of the sweeps
+		std::vector< double > _sweepRNorm2s( sweepRNorm2s ? iters : 0 , 0 );
 		for( ; residualWindow.end(!forward)*dir<FullWindow.end(forward)*dir ; residualWindow += dir , solveWindow += dir )
 		{
 			double t;
@@ -502,7 +519,9 @@ int FEMTree< Dim , Real >::_solveSlicedSystemGS( UIntPack< FEMSigs ... > , const
 				int b = block , _b = MOD( b , matrixBlocks ) , __b = MOD( b , solveBlocks );
 				ConstPointer( T ) B = _constraints[_b];
 				Pointer( T ) X = XBlocks( depth , b , solution );
-				_M[_b].gsIteration( mcIndices[__b] , ( ConstPointer( Real ) )_D[_b] , B , X , coarseToFine , true );
+				// The blocks trailing the front of the solve window have been relaxed by more sweeps
+				if( sweepRNorm2s ) _sweepRNorm2s[ ( ( solveWindow.begin(!forward) - block ) * dir ) / ColorModulus ] += _M[_b].gsIteration( mcIndices[__b] , ( ConstPointer( Real ) )_D[_b] , B , X , coarseToFine , true , Dot );
+				else                    _M[_b].gsIteration( mcIndices[__b] , ( ConstPointer( Real ) )_D[_b] , B , X , coarseToFine , true );
 			}
 			solveTime += Time() - t;
 
@@ -533,6 +552,7 @@ int FEMTree< Dim , Real >::_solveSlicedSystemGS( UIntPack< FEMSigs ... > , const
 		for( int i=0 ; i<matrixBlocks ; i++ ) FreePointer( _constraints[i] );
 
 		if( computeNorms ) stats.bNorm2 = bNorm , stats.inRNorm2 = inRNorm , stats.outRNorm2 = outRNorm;
+		if( sweepRNorm2s ) sweepRNorm2s->insert( sweepRNorm2s->end() , _sweepRNorm2s.begin() , _sweepRNorm2s.end() );
 		DeletePointer( _M );
 		DeletePointer( mcIndices );
 		FreePointer( _D );
@@ -543,7 +563,7 @@ int FEMTree< Dim , Real >::_solveSlicedSystemGS( UIntPack< FEMSigs ... > , const
 
 template< unsigned int Dim , class Real >
 template< unsigned int ... FEMSigs , typename T , typename TDotT , typename ... InterpolationInfos >
-int FEMTree< Dim , Real >::_solveSystemCG( UIntPack< FEMSigs ... > , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , _SolverStats& stats , bool computeNorms , double accuracy , std::tuple< InterpolationInfos *... > interpolationInfos ) const
+int FEMTree< Dim , Real >::_solveSystemCG( UIntPack< FEMSigs ... > , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , _SolverStats& stats , bool computeNorms , double accuracy , bool pipelined , int preconditioner , std::tuple< InterpolationInfos *... > interpolationInfos ) const
 {
 	int iter = 0;
 	Pointer( T ) X = GetPointer( &solution[0] + _sNodesBegin(depth) , _sNodesSize(depth) );
@@ -595,26 +615,21 @@ int FEMTree< Dim , Real >::_solveSystemCG( UIntPack< FEMSigs ... > , const typen
 	}
 
 	iters = (int)std::min< size_t >( nonZeroRows , iters );
-	struct SPDFunctor
+	Timer cgTimer;
+	if( iters )
 	{
-	protected:
-		const SystemMatrixType< FEMSigs ... > &_M;
-		bool _addDCTerm;
-	public:
-		SPDFunctor( const SystemMatrixType< FEMSigs ... > &M , bool addDCTerm ) : _M(M) , _addDCTerm(addDCTerm){ }
-		void operator()( ConstPointer( T ) in , Pointer( T ) out ) const
-		{
-			_M.multiply( in , out );
-			if( _addDCTerm )
-			{
-				T average = {};
-				for( matrix_index_type i=0 ; i<(matrix_index_type)_M.rows() ; i++ ) average += in[i];
-				average /= _M.rows();
-				for( matrix_index_type i=0 ; i<(matrix_index_type)_M.rows() ; i++ ) out[i] += average;
-			}
+		if( preconditioner==CG_PRECONDITIONER_NONE ) iter = (int)SolveFusedCG< T , Real >( M , addDCTerm , M.rows() , ( ConstPointer( T ) )B , iters , X , Real( accuracy ) , Dot , pipelined );
+		else
+		{
+			std::vector< std::vector< size_t > > multiColorIndices;
+			std::vector< size_t > blockStarts;
+			if( preconditioner==CG_PRECONDITIONER_SYMMETRIC_GAUSS_SEIDEL ) setMultiColorIndices( UIntPack< FEMSigs ... >() , depth , multiColorIndices );
+			if( preconditioner==CG_PRECONDITIONER_BLOCK_JACOBI ) _setSliceBlockStarts( depth , blockStarts );
+			CGPreconditioner< Real , SystemMatrixType< FEMSigs ... > > P( M , preconditioner , preconditioner==CG_PRECONDITIONER_SYMMETRIC_GAUSS_SEIDEL ? &multiColorIndices : NULL , &blockStarts );
+			iter = (int)SolveFusedCG< T , Real >( M , P , addDCTerm , M.rows() , ( ConstPointer( T ) )B , iters , X , Real( accuracy ) , Dot );
 		}
-	};
-	if( iters ) iter = (int)SolveCG< SPDFunctor , T , Real >( SPDFunctor( M , addDCTerm ) , M.rows() , ( ConstPointer( T ) )B , iters , X , Real( accuracy ) , Dot );
+	}
+	stats.cgIters = iter , stats.cgTime = cgTimer.wallTime();
 
 	solveTime = Time()-solveTime;
 	if( computeNorms )
@@ -655,7 +670,7 @@ void FEMTree< Dim , Real >::pushToBaseDepth( DenseNodeData< T , UIntPack< FEMSig
 
 template< unsigned int Dim , class Real >
 template< unsigned int ... FEMSigs , typename T , typename TDotT , typename ... InterpolationInfos >
-void FEMTree< Dim , Real >::_solveRegularMG( UIntPack< FEMSigs ... > , typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth maxSolveDepth , Pointer( T ) solution , ConstPointer( T ) constraints , TDotT Dot , int vCycles , int iters , _SolverStats& stats , bool computeNorms , double cgAccuracy , std::tuple< InterpolationInfos *... > interpolationInfos ) const
+void FEMTree< Dim , Real >::_solveRegularMG( UIntPack< FEMSigs ... > , typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth maxSolveDepth , Pointer( T ) solution , ConstPointer( T ) constraints , TDotT Dot , int vCycles , int iters , _SolverStats& stats , bool computeNorms , double cgAccuracy , bool pipelinedCG , int cgPreconditioner , bool directBaseSolve , double vCycleAccuracy , std::tuple< InterpolationInfos *... > interpolationInfos ) const
 {
 	if( maxSolveDepth>_baseDepth ) ERROR_OUT( "Regular MG depth cannot exceed base depth: " , maxSolveDepth , " <= " , _baseDepth );
 	double& systemTime = stats.systemTime;
@@ -693,6 +708,9 @@ void FEMTree< Dim , Real >::_solveRegularMG( UIntPack< FEMSigs ... > , typename
 	systemTime = Time() - systemTime;
 
 	solveTime = Time();
+	stats.cgIters = 0 , stats.cgTime = 0;
+	stats.directDepth = -1 , stats.directEntries = 0 , stats.directFactorTime = stats.directSolveTime = 0;
+	stats.vCycles = 0;
 
 	double bNorm = 0 , inRNorm = 0 , outRNorm = 0;
 	if( computeNorms )
@@ -714,10 +732,46 @@ void FEMTree< Dim , Real >::_solveRegularMG( UIntPack< FEMSigs ... > , typename
 		for( unsigned int t=0 ; t<ThreadPool::NumThreads() ; t++ ) bNorm += bNorms[t] , inRNorm += inRNorms[t];
 	}
 
+	// The DC term needs to be added if the system is singular, with the constant functions spanning the kernel
+	auto AddDCTerm = [&]( int d , size_t nonZeroRows )
+	{
+		size_t totalDim = 1;
+		int dims[] = { ( _BSplineEnd< FEMSigs >( d ) - _BSplineBegin< FEMSigs >( d ) ) ... };
+		for( int dd=0 ; dd<Dim ; dd++ ) totalDim *= dims[dd];
+		BoundaryType bTypes[] = { FEMSignature< FEMSigs >::BType ... };
+		bool hasPartitionOfUnity = true;
+		for( int dd=0 ; dd<Dim ; dd++ ) hasPartitionOfUnity &= HasPartitionOfUnity( bTypes[dd] );
+		return nonZeroRows==totalDim && !ConstrainsDCTerm( interpolationInfos ) && hasPartitionOfUnity && F.vanishesOnConstants();
+	};
+	auto NonZeroRows = [&]( int d )
+	{
+		size_t nonZeroRows = 0;
+		for( matrix_index_type i=0 ; i<(matrix_index_type)M[d].rows() ; i++ ) if( M[d].rowSize(i) ) nonZeroRows++;
+		return nonZeroRows;
+	};
+
+	// If requested, factor the system at the finest depth whose factorization is affordable and solve directly there, re-using the factor across the v-cycles
+	// (Falls back to conjugate-gradients at depth zero if no factorization succeeds.)
+	static const double MaxDirectFactorCost = (double)( 1<<27 );
+	int coarseDepth = 0;
+	EnvelopeCholesky cholesky;
+	if( directBaseSolve )
+	{
+		Timer factorTimer;
+		int d = 0;
+		while( d<std::min< int >( maxSolveDepth , _baseDepth ) && EnvelopeCholesky::FactorCost( M[d+1] )<=MaxDirectFactorCost ) d++;
+		if( cholesky.factor( M[d] , AddDCTerm( d , NonZeroRows( d ) ) ) ) coarseDepth = stats.directDepth = d , stats.directEntries = cholesky.entries();
+		stats.directFactorTime = factorTimer.wallTime();
+	}
+
+	std::vector< size_t > baseBlockStarts;
+	if( stats.directDepth<0 && cgPreconditioner==CG_PRECONDITIONER_BLOCK_JACOBI ) _setSliceBlockStarts( 0 , baseBlockStarts );
+	CGPreconditioner< Real , SparseMatrix< Real , matrix_index_type > > baseP( M[0] , stats.directDepth<0 ? cgPreconditioner : CG_PRECONDITIONER_NONE , &multiColorIndices[0] , &baseBlockStarts );
+
 	for( int v=0 ; v<vCycles ; v++ )
 	{
 		// Restriction
-		for( int d=_baseDepth ; d>0 ; d-- )
+		for( int d=_baseDepth ; d>coarseDepth ; d-- )
 		{
 			ConstPointer( T ) __B = d==_baseDepth ? _B : B[d];
 			if( d<=maxSolveDepth ) for( int i=0 ; i<iters ; i++ ) M[d].gsIteration( multiColorIndices[d] , D[d] , __B , X[d] , true , true );
@@ -728,49 +782,55 @@ void FEMTree< Dim , Real >::_solveRegularMG( UIntPack< FEMSigs ... > , typename
 		}
 
 		// Base
+		if( stats.directDepth>=0 )
+		{
+			int d = coarseDepth;
+			ConstPointer( T ) __B = d==_baseDepth ? _B : B[d];
+			Timer solveTimer;
+			cholesky.solve( __B , X[d] );
+			stats.directSolveTime += solveTimer.wallTime();
+		}
+		else
 		{
 			int d = 0;
 			ConstPointer( T ) __B = d==_baseDepth ? _B : B[d];
-			struct SPDFunctor
-			{
-			protected:
-				const SparseMatrix< Real , matrix_index_type >& _M;
-				bool _addDCTerm;
-			public:
-				SPDFunctor( const SparseMatrix< Real , matrix_index_type  >& M , bool addDCTerm ) : _M(M) , _addDCTerm(addDCTerm){ }
-				void operator()( ConstPointer( T ) in , Pointer( T ) out ) const
-				{
-					_M.multiply( in , out );
-					if( _addDCTerm )
-					{
-						T average = {};
-						for( matrix_index_type i=0 ; i<(matrix_index_type)_M.rows() ; i++ ) average += in[i];
-						average /= _M.rows();
-						for( matrix_index_type i=0 ; i<(matrix_index_type)_M.rows() ; i++ ) out[i] += average;
-					}
-				}
-			};
-			size_t nonZeroRows = 0;
-			for( matrix_index_type i=0 ; i<(matrix_index_type)M[d].rows() ; i++ ) if( M[d].rowSize(i) ) nonZeroRows++;
-			size_t totalDim = 1;
-			int dims[] = { ( _BSplineEnd< FEMSigs >( _baseDepth ) - _BSplineBegin< FEMSigs >( _baseDepth ) ) ... };
-			for( int dd=0 ; dd<Dim ; dd++ ) totalDim *= dims[dd];
-			BoundaryType bTypes[] = { FEMSignature< FEMSigs >::BType ... };
-			bool hasPartitionOfUnity = true;
-			for( int dd=0 ; dd<Dim ; dd++ ) hasPartitionOfUnity &= HasPartitionOfUnity( bTypes[dd] );
-			bool addDCTerm = ( nonZeroRows==totalDim && !ConstrainsDCTerm( interpolationInfos ) && hasPartitionOfUnity && F.vanishesOnConstants() );
+			size_t nonZeroRows = NonZeroRows( d );
+			bool addDCTerm = AddDCTerm( _baseDepth , nonZeroRows );
 
-			SolveCG< SPDFunctor , T , Real >( SPDFunctor( M[d] , addDCTerm ) , M[d].rows() , ( ConstPointer( T ) )__B , nonZeroRows , X[d] , Real( cgAccuracy ) , Dot );
+			Timer cgTimer;
+			if( cgPreconditioner==CG_PRECONDITIONER_NONE ) stats.cgIters += SolveFusedCG< T , Real >( M[d] ,         addDCTerm , M[d].rows() , ( ConstPointer( T ) )__B , nonZeroRows , X[d] , Real( cgAccuracy ) , Dot , pipelinedCG );
+			else                                           stats.cgIters += SolveFusedCG< T , Real >( M[d] , baseP , addDCTerm , M[d].rows() , ( ConstPointer( T ) )__B , nonZeroRows , X[d] , Real( cgAccuracy ) , Dot );
+			stats.cgTime += cgTimer.wallTime();
 		}
 
 		// Prolongation
-		for( int d=1 ; d<=_baseDepth ; d++ )
+		for( int d=coarseDepth+1 ; d<=_baseDepth ; d++ )
 		{
 			ConstPointer( T ) __B = d==_baseDepth ? _B : B[d];
 			P[d-1].multiply( X[d-1] , X[d] , MULTIPLY_ADD );
 			for( matrix_index_type i=0 ; i<(matrix_index_type)M[d-1].rows() ; i++ ) X[d-1][i] *= 0;
 			if( d<=maxSolveDepth ) for( int i=0 ; i<iters ; i++ ) M[d].gsIteration( multiColorIndices[d] , D[d] , __B , X[d] , false , true );
 		}
+		stats.vCycles++;
+
+		// Stop once the residual at the base depth is small enough
+		if( vCycleAccuracy>0 && v<vCycles-1 )
+		{
+			const SparseMatrix< Real , matrix_index_type >& _M = M.back();
+			ConstPointer( T ) _X = X.back();
+			std::vector< double > bNorms( ThreadPool::NumThreads() , 0 ) , rNorms( ThreadPool::NumThreads() , 0 );
+			ThreadPool::Parallel_for( 0 , _M.rows() , [&]( unsigned int thread , size_t j )
+			{
+				T temp = {};
+				for( auto iter=_M.begin(j) ; iter!=_M.end(j) ; iter++ ) temp += _X[ iter->N ] * iter->Value;
+				bNorms[thread] += Dot( _B[j] , _B[j] );
+				rNorms[thread] += Dot( temp-_B[j] , temp-_B[j] );
+			}
+			);
+			double _bNorm = 0 , rNorm = 0;
+			for( unsigned int t=0 ; t<ThreadPool::NumThreads() ; t++ ) _bNorm += bNorms[t] , rNorm += rNorms[t];
+			if( rNorm<=vCycleAccuracy * vCycleAccuracy * _bNorm ) break;
+		}
 	}
 	if( computeNorms )
 	{
@@ -2349,6 +2409,13 @@ DenseNodeData< Real , UIntPack< FEMSigs ... > > FEMTree< Dim , Real >::prolongat
 template< unsigned int Dim , class Real >
 template< class C , typename ArrayWrapper , unsigned int ... Degrees , unsigned int ... FEMSigs >
 void FEMTree< Dim , Real >::_upSample( UIntPack< FEMSigs ... > , typename BaseFEMIntegrator::template RestrictionProlongation< UIntPack< Degrees ... > >& rp , LocalDepth highDepth , ArrayWrapper coarserCoefficients , Pointer( C ) finerCoefficients ) const
+{
+	_upSample( UIntPack< FEMSigs ... >() , rp , highDepth , coarserCoefficients , finerCoefficients , _sNodesBegin(highDepth) , _sNodesEnd(highDepth) );
+}
+
+template< unsigned int Dim , class Real >
+template< class C , typename ArrayWrapper , unsigned int ... Degrees , unsigned int ... FEMSigs >
+void FEMTree< Dim , Real >::_upSample( UIntPack< FEMSigs ... > , typename BaseFEMIntegrator::template RestrictionProlongation< UIntPack< Degrees ... > >& rp , LocalDepth highDepth , ArrayWrapper coarserCoefficients , Pointer( C ) finerCoefficients , node_index_type nBegin , node_index_type nEnd ) const
 {
 	LocalDepth lowDepth = highDepth-1;
 	if( lowDepth<0 ) return;
@@ -2376,7 +2443,7 @@ void FEMTree< Dim , Real >::_upSample( UIntPack< FEMSigs ... > , typename BaseFE
 	} 
 	);
 	// For Dirichlet constraints, can't get to all children from parents because boundary nodes are invalid
-	ThreadPool::Parallel_for( _sNodesBegin(highDepth) , _sNodesEnd(highDepth) , [&]( unsigned int thread , size_t i )
+	ThreadPool::Parallel_for( nBegin , nEnd , [&]( unsigned int thread , size_t i )
 	{
 		if( _isValidFEM1Node( _sNodes.treeNodes[i] ) )
 		{
@@ -2743,20 +2810,26 @@ void FEMTree< Dim , Real >::solveSystem( UIntPack< FEMSigs ... > , typename Base
 		if( solverInfo.showResidual && showResidual )
 		{
 			for( int d=_baseDepth ; d<depth ; d++ ) printf( "  " );
-			if     ( depth==_baseDepth )         printf( "MG x %d" , solverInfo.baseVCycles );
+			if     ( depth==_baseDepth )         printf( "MG x %d" , solverInfo.baseVCycles ? sStats.vCycles : 0 );
 			else if( depth<=solverInfo.cgDepth ) printf( "    CG" );
 			else                                 printf( "    GS" );
-			printf( ": %.4e -> %.4e -> %.4e (%.1e) [%d]\n" , sqrt( sStats.bNorm2 ) , sqrt( sStats.inRNorm2 ) , sqrt( sStats.outRNorm2 ) , sqrt( sStats.outRNorm2  / sStats.inRNorm2 ) , actualIters );
+			printf( ": %.4e -> %.4e -> %.4e (%.1e) [%d]" , sqrt( sStats.bNorm2 ) , sqrt( sStats.inRNorm2 ) , sqrt( sStats.outRNorm2 ) , sqrt( sStats.outRNorm2  / sStats.inRNorm2 ) , actualIters );
+			if( depth==_baseDepth && sStats.directDepth>=0 ) printf( "\tDirect[%d]: %llu entries @ %.3e / %.3e s" , sStats.directDepth , (unsigned long long)sStats.directEntries , sStats.directFactorTime , sStats.directSolveTime );
+			if( ( depth==_baseDepth || depth<=solverInfo.cgDepth ) && sStats.cgIters ) printf( "\tCG: %llu iterations @ %.3e s" , (unsigned long long)sStats.cgIters , sStats.cgTime / sStats.cgIters );
+			printf( "\n" );
 		}
 	};
 
 	// Set the cumulative solution
 	if( !solverInfo.clearSolution ) for( LocalDepth d=_baseDepth ; d<maxSolveDepth ; d++ ) UpdateProlongation( d );
 
-	_SolverStats sStats;
+	_SolverStats sStats = {};
 	bool showResidual;
 	int actualIters;
 	double t;
+	// The Gauss-Seidel sweeps performed and scheduled, and the residual at the finest depth
+	size_t sweeps = 0 , maxSweeps = 0;
+	double finestBNorm2 = 0 , finestRNorm2 = 0;
 
 	struct TrivialSORWeights{ Real operator[] ( node_index_type idx ) const { return (Real)1; } };
 	struct SORWeights
@@ -2800,12 +2873,12 @@ void FEMTree< Dim , Real >::solveSystem( UIntPack< FEMSigs ... > , typename Base
 				// In the restriction phase we do not solve at the coarsest resolution since we will do so in the prolongation phase
 				if( d==_baseDepth )
 				{
-					if( solverInfo.baseVCycles ) _solveRegularMG( UIntPack< FEMSigs ... >() , F , bsData , std::min< LocalDepth >( _baseDepth , maxSolveDepth ) , _solution , d==_maxDepth ? _constraints : _residualConstraints , Dot , solverInfo.baseVCycles , iters , sStats , solverInfo.showResidual , solverInfo.cgAccuracy , interpolationInfos );
+					if( solverInfo.baseVCycles ) _solveRegularMG( UIntPack< FEMSigs ... >() , F , bsData , std::min< LocalDepth >( _baseDepth , maxSolveDepth ) , _solution , d==_maxDepth ? _constraints : _residualConstraints , Dot , solverInfo.baseVCycles , iters , sStats , solverInfo.showResidual , solverInfo.cgAccuracy , solverInfo.pipelinedCG , solverInfo.cgPreconditioner , solverInfo.directBaseSolve , solverInfo.vCycleAccuracy , interpolationInfos );
 				}
 				else
 				{
-					if( d>solverInfo.cgDepth ) actualIters = _solveSystemGS( UIntPack< FEMSigs ... >() , Dim!=1 , F , bsData , d , _solution , ( ConstPointer( T ) )_prolongedSolution , d==_maxDepth ? _constraints : _residualConstraints , Dot , iters , coarseToFine , solverInfo.sliceBlockSize , sorWeights , sStats , solverInfo.showResidual ,                         interpolationInfos );
-					else                       actualIters = _solveSystemCG( UIntPack< FEMSigs ... >() ,          F , bsData , d , _solution , ( ConstPointer( T ) )_prolongedSolution , d==_maxDepth ? _constraints : _residualConstraints , Dot , iters , coarseToFine ,                                          sStats , solverInfo.showResidual , solverInfo.cgAccuracy , interpolationInfos );
+					if( d>solverInfo.cgDepth ) actualIters = _solveSystemGS( UIntPack< FEMSigs ... >() , Dim!=1 , F , bsData , d , _solution , ( ConstPointer( T ) )_prolongedSolution , d==_maxDepth ? _constraints : _residualConstraints , Dot , iters , coarseToFine , solverInfo.sliceBlockSize , sorWeights , sStats , solverInfo.showResidual , solverInfo.sweepAccuracy , solverInfo.sweepStagnation , interpolationInfos ) , sweeps += actualIters , maxSweeps += iters;
+					else                       actualIters = _solveSystemCG( UIntPack< FEMSigs ... >() ,          F , bsData , d , _solution , ( ConstPointer( T ) )_prolongedSolution , d==_maxDepth ? _constraints : _residualConstraints , Dot , iters , coarseToFine ,                                          sStats , solverInfo.showResidual , solverInfo.cgAccuracy , solverInfo.pipelinedCG , solverInfo.cgPreconditioner , interpolationInfos );
 				}
 				t = Time();
 				UpdateRestriction( d );
@@ -2829,23 +2902,27 @@ void FEMTree< Dim , Real >::solveSystem( UIntPack< FEMSigs ... > , typename Base
 			SetResidualConstraints( d );
 			sStats.constraintUpdateTime += Time()-t;
 			actualIters = iters;
+			// The norms at the finest depth are needed to decide if we can stop cycling
+			bool computeNorms = solverInfo.showResidual || ( solverInfo.vCycleAccuracy>0 && d==maxSolveDepth );
 			if( d==_baseDepth )
 			{
-				if( solverInfo.baseVCycles ) _solveRegularMG( UIntPack< FEMSigs ... >() , F , bsData , std::min< LocalDepth >( _baseDepth , maxSolveDepth ) , _solution , d==_maxDepth ? _constraints : _residualConstraints , Dot , solverInfo.baseVCycles , iters , sStats , solverInfo.showResidual , solverInfo.cgAccuracy , interpolationInfos );
+				if( solverInfo.baseVCycles ) _solveRegularMG( UIntPack< FEMSigs ... >() , F , bsData , std::min< LocalDepth >( _baseDepth , maxSolveDepth ) , _solution , d==_maxDepth ? _constraints : _residualConstraints , Dot , solverInfo.baseVCycles , iters , sStats , computeNorms , solverInfo.cgAccuracy , solverInfo.pipelinedCG , solverInfo.cgPreconditioner , solverInfo.directBaseSolve , solverInfo.vCycleAccuracy , interpolationInfos );
 			}
 			else
 			{
-				if( d>solverInfo.cgDepth ) actualIters = _solveSystemGS( UIntPack< FEMSigs ... >() , Dim!=1 , F , bsData , d , _solution , ( ConstPointer( T ) )_prolongedSolution , d==_maxDepth ? _constraints : _residualConstraints , Dot , iters , coarseToFine , solverInfo.sliceBlockSize , sorWeights , sStats , solverInfo.showResidual , interpolationInfos );
-				else                       actualIters = _solveSystemCG( UIntPack< FEMSigs ... >() ,          F , bsData , d , _solution , ( ConstPointer( T ) )_prolongedSolution , d==_maxDepth ? _constraints : _residualConstraints , Dot , iters , coarseToFine , sStats , solverInfo.showResidual , solverInfo.cgAccuracy , interpolationInfos );
+				if( d>solverInfo.cgDepth ) actualIters = _solveSystemGS( UIntPack< FEMSigs ... >() , Dim!=1 , F , bsData , d , _solution , ( ConstPointer( T ) )_prolongedSolution , d==_maxDepth ? _constraints : _residualConstraints , Dot , iters , coarseToFine , solverInfo.sliceBlockSize , sorWeights , sStats , computeNorms , solverInfo.sweepAccuracy , solverInfo.sweepStagnation , interpolationInfos ) , sweeps += actualIters , maxSweeps += iters;
+				else                       actualIters = _solveSystemCG( UIntPack< FEMSigs ... >() ,          F , bsData , d , _solution , ( ConstPointer( T ) )_prolongedSolution , d==_maxDepth ? _constraints : _residualConstraints , Dot , iters , coarseToFine , sStats , computeNorms , solverInfo.cgAccuracy , solverInfo.pipelinedCG , solverInfo.cgPreconditioner , interpolationInfos );
 			}
 			t = Time();
 			UpdateProlongation( d );
 			sStats.constraintUpdateTime += Time()-t;
+			if( d==maxSolveDepth ) finestBNorm2 = sStats.bNorm2 , finestRNorm2 = sStats.outRNorm2;
 			OutputSolverStats( v , d , sStats , showResidual , actualIters );
 		}
 	};
 
-	for( int v=0 ; v<solverInfo.vCycles ; v++ )
+	int v;
+	for( v=0 ; v<solverInfo.vCycles ; v++ )
 	{
 		if( solverInfo.wCycle )
 		{
@@ -2873,7 +2950,7 @@ void FEMTree< Dim , Real >::solveSystem( UIntPack< FEMSigs ... > , typename Base
 			{
 				F.init( d );
 				SetResidualConstraints( d );
-				_solveSystemGS( UIntPack< FEMSigs ... >() , Dim!=1 , F , bsData , d , _solution , ( ConstPointer( T ) )_prolongedSolution , d==_maxDepth ? _constraints : _residualConstraints , Dot , 0 , coarseToFine , solverInfo.sliceBlockSize , TrivialSORWeights() , sStats , true , interpolationInfos );
+				_solveSystemGS( UIntPack< FEMSigs ... >() , Dim!=1 , F , bsData , d , _solution , ( ConstPointer( T ) )_prolongedSolution , d==_maxDepth ? _constraints : _residualConstraints , Dot , 0 , coarseToFine , solverInfo.sliceBlockSize , TrivialSORWeights() , sStats , true , 0. , 0. , interpolationInfos );
 				UpdateRestriction( d );
 				rNorms[d] = sqrt( sStats.outRNorm2 / _bNorm2[d] );
 			}
@@ -2881,7 +2958,11 @@ void FEMTree< Dim , Real >::solveSystem( UIntPack< FEMSigs ... > , typename Base
 			for( int d=_baseDepth ; d<=maxSolveDepth ; d++ ) printf( "\t%.4e" , rNorms[d] );
 			printf( "\n" );
 		}
+		// Stop cycling once the residual at the finest depth is small enough
+		if( solverInfo.vCycleAccuracy>0 && finestRNorm2<=solverInfo.vCycleAccuracy * solverInfo.vCycleAccuracy * finestBNorm2 ){ v++ ; break; }
 	}
+	if( ( solverInfo.verbose || solverInfo.showResidual ) && ( solverInfo.sweepAccuracy>0 || solverInfo.sweepStagnation>0 || solverInfo.vCycleAccuracy>0 ) )
+		printf( "Adaptive solver: %llu / %llu sweeps (%llu saved) , %d / %d v-cycles\n" , (unsigned long long)sweeps , (unsigned long long)maxSweeps , (unsigned long long)( maxSweeps-sweeps ) , v , solverInfo.vCycles );
 
 	FreePointer( _residualConstraints );
 	FreePointer( _restrictedConstraints );
@@ -188,34 +188,62 @@ void FEMTree< Dim , Real >::_addWeightContribution( Allocator< FEMTreeNode > *no
 
 template< unsigned int Dim , class Real >
 template< unsigned int WeightDegree , class PointSupportKey >
-Real FEMTree< Dim , Real >::_getSamplesPerNode( const DensityEstimator< WeightDegree >& densityWeights , const FEMTreeNode* node , Point< Real , Dim > position , PointSupportKey& weightKey ) const
+void FEMTree< Dim , Real >::_getSamplesPerNode( const DensityEstimator< WeightDegree >& densityWeights , const FEMTreeNode* node , const Point< Real , Dim > *positions , const unsigned int *indices , unsigned int count , PointSupportKey& weightKey , Real *samplesPerNode ) const
 {
-	Real weight = 0;
 	typedef typename PointSupportKey::NeighborType Neighbors;
-	double values[ Dim ][ BSplineSupportSizes< WeightDegree >::SupportSize ];
+	static const unsigned int NeighborNum = WindowSize< IsotropicUIntPack< Dim , BSplineSupportSizes< WeightDegree >::SupportSize > >::Size;
 	Neighbors neighbors = weightKey.getNeighbors( node );
 	Point< Real , Dim > start;
 	Real w;
 	_startAndWidth( node , start , w );
 
-	for( int dim=0 ; dim<Dim ; dim++ ) Polynomial< WeightDegree >::BSplineComponentValues( ( position[dim]-start[dim] ) / w , values[dim] );
-	double scratch[Dim+1];
-	scratch[0] = 1;
-	WindowLoop< Dim >::Run
-	(
-		IsotropicUIntPack< Dim , 0 >() , IsotropicUIntPack< Dim , BSplineSupportSizes< WeightDegree >::SupportSize >() ,
-		[&]( int d , int i ){ scratch[d+1] = scratch[d] * values[d][i]; } ,
-		[&]( typename Neighbors::Window::data_type node ){ if( node ){ const Real* w = densityWeights( node ) ; if( w ) weight += (Real)( scratch[Dim] * (*w) ); } } ,
-		neighbors.neighbors()
-	);
-	return weight;
+	// Look up the density weights of the neighbors once and share them across the positions
+	const Real *nodeWeights[ NeighborNum ];
+	{
+		unsigned int idx = 0;
+		WindowLoop< Dim >::Run
+		(
+			IsotropicUIntPack< Dim , 0 >() , IsotropicUIntPack< Dim , BSplineSupportSizes< WeightDegree >::SupportSize >() ,
+			[&]( int , int ){} ,
+			[&]( typename Neighbors::Window::data_type node ){ nodeWeights[idx++] = node ? densityWeights( node ) : NULL; } ,
+			neighbors.neighbors()
+		);
+	}
+
+	for( unsigned int i=0 ; i<count ; i++ )
+	{
+		Point< Real , Dim > position = positions[ indices[i] ];
+		double values[ Dim ][ BSplineSupportSizes< WeightDegree >::SupportSize ];
+		for( int dim=0 ; dim<Dim ; dim++ ) Polynomial< WeightDegree >::BSplineComponentValues( ( position[dim]-start[dim] ) / w , values[dim] );
+		Real weight = 0;
+		double scratch[Dim+1];
+		scratch[0] = 1;
+		unsigned int idx = 0;
+		WindowLoop< Dim >::Run
+		(
+			IsotropicUIntPack< Dim , 0 >() , IsotropicUIntPack< Dim , BSplineSupportSizes< WeightDegree >::SupportSize >() ,
+			[&]( int d , int i ){ scratch[d+1] = scratch[d] * values[d][i]; } ,
+			[&]( typename Neighbors::Window::data_type ){ if( nodeWeights[idx] ) weight += (Real)( scratch[Dim] * (*nodeWeights[idx]) ) ; idx++; } ,
+			neighbors.neighbors()
+		);
+		samplesPerNode[ indices[i] ] = weight;
+	}
 }
+
 template< unsigned int Dim , class Real >
 template< unsigned int WeightDegree , class PointSupportKey >
-void FEMTree< Dim , Real >::_getSampleDepthAndWeight( const DensityEstimator< WeightDegree >& densityWeights , const FEMTreeNode* node , Point< Real , Dim > position , PointSupportKey& weightKey , Real& depth , Real& weight ) const
+Real FEMTree< Dim , Real >::_getSamplesPerNode( const DensityEstimator< WeightDegree >& densityWeights , const FEMTreeNode* node , Point< Real , Dim > position , PointSupportKey& weightKey ) const
+{
+	unsigned int index = 0;
+	Real samplesPerNode;
+	_getSamplesPerNode( densityWeights , node , &position , &index , 1 , weightKey , &samplesPerNode );
+	return samplesPerNode;
+}
+
+template< unsigned int Dim , class Real >
+template< unsigned int WeightDegree , class PointSupportKey >
+void FEMTree< Dim , Real >::_getSampleDepthsAndWeights( const DensityEstimator< WeightDegree >& densityWeights , const FEMTreeNode* node , const Point< Real , Dim > *positions , unsigned int count , PointSupportKey& weightKey , Real *depths , Real *weights ) const
 {
-	const FEMTreeNode* temp = node;
-	while( _localDepth( temp )>densityWeights.kernelDepth() ) temp = temp->parent;
 	// Goal:
 	// Find the depth d at which the number of samples per node is equal to densityWeights.samplesPerNode.
 	// Assume that the number of samples per node grows by a factor of 2^( Dim-CoDim ) as the depth is decreased by 1.
@@ -234,26 +262,63 @@ void FEMTree< Dim , Real >::_getSampleDepthAndWeight( const DensityEstimator< We
 	//		d = [ log( spd_0 ) - log( spd ) + log(2) * ( d_0 * ( Dim - CoDim ) ) ) ] / [ log(2) * ( Dim-CoDim ) ]
 	//		d = [ log( spd_0 / spd ) ] / [ log(2) * ( Dim-CoDim ) ]  + d_0
 
-	Real samplesPerNode = _getSamplesPerNode( densityWeights , temp , position , weightKey );
-	if( samplesPerNode>=densityWeights.samplesPerNode() ) depth = Real( _localDepth( temp ) + log( samplesPerNode / densityWeights.samplesPerNode() ) / ( log(2.) * ( Dim-densityWeights.coDimension() ) ) );
-	else
+	// The positions are processed in batches that walk up the tree together, so that the density weights at each depth are looked up once per batch.
+	static const unsigned int BatchSize = 32;
+	unsigned int indices[ BatchSize ];
+	Real fineSamplesPerNode[ BatchSize ] , coarseSamplesPerNode[ BatchSize ];
+	for( unsigned int b=0 ; b<count ; b+=BatchSize )
 	{
-		Real fineSamplesPerNode , coarseSamplesPerNode;
-		fineSamplesPerNode = coarseSamplesPerNode = samplesPerNode;
-		while( coarseSamplesPerNode<densityWeights.samplesPerNode() && _localDepth(temp) )
+		const Point< Real , Dim > *_positions = positions + b;
+		Real *_depths = depths + b , *_weights = weights + b;
+		unsigned int _count = std::min< unsigned int >( count-b , BatchSize ) , activeCount = 0;
+
+		const FEMTreeNode* temp = node;
+		while( _localDepth( temp )>densityWeights.kernelDepth() ) temp = temp->parent;
+		auto SetWeight = [&]( unsigned int i , Real samplesPerNode )
 		{
-			temp = temp->parent;
-			fineSamplesPerNode = coarseSamplesPerNode;
-			coarseSamplesPerNode = _getSamplesPerNode( densityWeights , temp , position , weightKey );
-		}
+			Real nodeWidth = (Real)( 1. / (1<<_localDepth(temp) ) );
+			_weights[i] = (Real)pow( nodeWidth , Dim-densityWeights.coDimension() ) / samplesPerNode;
+		};
+
+		for( unsigned int i=0 ; i<_count ; i++ ) indices[i] = i;
+		_getSamplesPerNode( densityWeights , temp , _positions , indices , _count , weightKey , coarseSamplesPerNode );
+		for( unsigned int i=0 ; i<_count ; i++ )
+			if( coarseSamplesPerNode[i]>=densityWeights.samplesPerNode() )
+			{
+				_depths[i] = Real( _localDepth( temp ) + log( coarseSamplesPerNode[i] / densityWeights.samplesPerNode() ) / ( log(2.) * ( Dim-densityWeights.coDimension() ) ) );
+				SetWeight( i , coarseSamplesPerNode[i] );
+			}
+			else fineSamplesPerNode[i] = coarseSamplesPerNode[i] , indices[ activeCount++ ] = i;
+
 		// Rather than assuming that the number of samples per node scales by a factor of 2^(Dim-CoDim),
 		// use the fact that between the coarse and fine levels the samples per node scaled by coarseSamplesPerNode / fineSamplesPerNode
-		depth = Real( _localDepth( temp ) + log( coarseSamplesPerNode / densityWeights.samplesPerNode() ) / log( coarseSamplesPerNode / fineSamplesPerNode ) );
-		samplesPerNode = coarseSamplesPerNode;
+		auto SetCoarseDepthAndWeight = [&]( unsigned int i )
+		{
+			_depths[i] = Real( _localDepth( temp ) + log( coarseSamplesPerNode[i] / densityWeights.samplesPerNode() ) / log( coarseSamplesPerNode[i] / fineSamplesPerNode[i] ) );
+			SetWeight( i , coarseSamplesPerNode[i] );
+		};
+		while( activeCount && _localDepth(temp) )
+		{
+			temp = temp->parent;
+			for( unsigned int a=0 ; a<activeCount ; a++ ) fineSamplesPerNode[ indices[a] ] = coarseSamplesPerNode[ indices[a] ];
+			_getSamplesPerNode( densityWeights , temp , _positions , indices , activeCount , weightKey , coarseSamplesPerNode );
+			unsigned int _activeCount = 0;
+			for( unsigned int a=0 ; a<activeCount ; a++ )
+				if( coarseSamplesPerNode[ indices[a] ]<densityWeights.samplesPerNode() && _localDepth(temp) ) indices[ _activeCount++ ] = indices[a];
+				else SetCoarseDepthAndWeight( indices[a] );
+			activeCount = _activeCount;
+		}
+		for( unsigned int a=0 ; a<activeCount ; a++ ) SetCoarseDepthAndWeight( indices[a] );
 	}
-	Real nodeWidth = (Real)( 1. / (1<<_localDepth(temp) ) );
-	weight = (Real)pow( nodeWidth , Dim-densityWeights.coDimension() ) / samplesPerNode;
 }
+
+template< unsigned int Dim , class Real >
+template< unsigned int WeightDegree , class PointSupportKey >
+void FEMTree< Dim , Real >::_getSampleDepthAndWeight( const DensityEstimator< WeightDegree >& densityWeights , const FEMTreeNode* node , Point< Real , Dim > position , PointSupportKey& weightKey , Real& depth , Real& weight ) const
+{
+	_getSampleDepthsAndWeights( densityWeights , node , &position , 1 , weightKey , &depth , &weight );
+}
+
 template< unsigned int Dim , class Real >
 template< unsigned int WeightDegree , class PointSupportKey >
 void FEMTree< Dim , Real >::_getSampleDepthAndWeight( const DensityEstimator< WeightDegree >& densityWeights , Point< Real , Dim > position , PointSupportKey& weightKey , Real& depth , Real& weight ) const
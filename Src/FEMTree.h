@@ -2067,12 +2067,23 @@ protected:
 public:
 	template< unsigned int ... FEMSigs > void setMultiColorIndices( UIntPack< FEMSigs ... > , int depth , std::vector< std::vector< size_t > >& indices ) const;
 protected:
+	// Sets the offsets of the (non-empty) slices at the given depth, relative to the start of the depth
+	void _setSliceBlockStarts( LocalDepth depth , std::vector< size_t > &blockStarts ) const;
 	template< unsigned int ... FEMSigs > void _setMultiColorIndices( UIntPack< FEMSigs ... > , node_index_type start , node_index_type end , std::vector< std::vector< size_t > >& indices ) const;
 
 	struct _SolverStats
 	{
 		double constraintUpdateTime , systemTime , solveTime;
 		double bNorm2 , inRNorm2 , outRNorm2;
+		// The conjugate-gradient iterations performed and the time spent in them
+		size_t cgIters;
+		double cgTime;
+		// The depth, factor size, and factorization/solve times of the direct base solver (coarse depth is -1 if it is not used)
+		int directDepth;
+		size_t directEntries;
+		double directFactorTime , directSolveTime;
+		// The number of v-cycles performed by the regular multigrid solver
+		int vCycles;
 	};
 
 	// For some reason MSVC has trouble determining the template parameters when using:
@@ -2160,19 +2171,43 @@ protected:
 	T _getConstraintFromProlongedSolution( UIntPack< FEMSigs ... > , const BaseSystem< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const typename FEMTreeNode::template ConstNeighbors< UIntPack< BSplineOverlapSizes< FEMSignature< FEMSigs >::Degree >::OverlapSize ... > >& neighbors , const typename FEMTreeNode::template ConstNeighbors< UIntPack< BSplineOverlapSizes< FEMSignature< FEMSigs >::Degree >::OverlapSize ... > >& pNeighbors , const FEMTreeNode* node , ConstPointer( T ) prolongedSolution , const DynamicWindow< double , UIntPack< BSplineOverlapSizes< FEMSignature< FEMSigs >::Degree >::OverlapSize ... > >& stencil , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , std::tuple< InterpolationInfos *... > interpolationInfos ) const;
 
 	template< unsigned int ... FEMSigs , typename T , typename TDotT , typename SORWeights , typename ... InterpolationInfos >
-	int _solveFullSystemGS( UIntPack< FEMSigs ... > , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , SORWeights sorWeights , _SolverStats& stats , bool computeNorms , std::tuple< InterpolationInfos *... > interpolationInfos ) const;
+	int _solveFullSystemGS( UIntPack< FEMSigs ... > , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , SORWeights sorWeights , _SolverStats& stats , bool computeNorms , double sweepAccuracy , double sweepStagnation , std::tuple< InterpolationInfos *... > interpolationInfos ) const;
 	template< unsigned int ... FEMSigs , typename T , typename TDotT , typename SORWeights , typename ... InterpolationInfos >
-	int _solveSlicedSystemGS( UIntPack< FEMSigs ... > , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , unsigned int sliceBlockSize , SORWeights sorWeights , _SolverStats& stats , bool computeNorms , std::tuple< InterpolationInfos *... > interpolationInfos ) const;
+	int _solveSlicedSystemGS( UIntPack< FEMSigs ... > , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , unsigned int sliceBlockSize , SORWeights sorWeights , _SolverStats& stats , bool computeNorms , std::vector< double > *sweepRNorm2s , std::tuple< InterpolationInfos *... > interpolationInfos ) const;
 	template< unsigned int ... FEMSigs , typename T , typename TDotT , typename SORWeights , typename ... InterpolationInfos >
-	int _solveSystemGS( UIntPack< FEMSigs ... > , bool sliced , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , unsigned int sliceBlockSize , SORWeights sorWeights , _SolverStats& stats , bool computeNorms , std::tuple< InterpolationInfos *... > interpolationInfos ) const
+	int _solveSystemGS( UIntPack< FEMSigs ... > , bool sliced , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , unsigned int sliceBlockSize , SORWeights sorWeights , _SolverStats& stats , bool computeNorms , double sweepAccuracy , double sweepStagnation , std::tuple< InterpolationInfos *... > interpolationInfos ) const
+	{
+		if( !sliced || sliceBlockSize<=0 ) return _solveFullSystemGS( UIntPack< FEMSigs ... >() , F , bsData , depth , solution , prolongedSolution , constraints , Dot , iters , coarseToFine , sorWeights , stats , computeNorms , sweepAccuracy , sweepStagnation , interpolationInfos );
+		else if( sweepAccuracy<=0 && sweepStagnation<=0 ) return _solveSlicedSystemGS( UIntPack< FEMSigs ... >() , F , bsData , depth , solution , prolongedSolution , constraints , Dot , iters , coarseToFine , sliceBlockSize , sorWeights , stats , computeNorms , NULL , interpolationInfos );
+
+		// The temporally blocked solver pipelines the sweeps through the slices, so the residual of a sweep is only known once all the sweeps have completed.
+		// Instead, we relax in rounds of a few sweeps, re-assembling the slice matrices for each round, and stop between rounds.
+		static const int RoundSweeps = 2;
+		std::vector< double > sweepRNorm2s;
+		double systemTime = 0 , solveTime = 0 , bNorm2 = 0 , inRNorm2 = 0;
+		int sweeps = 0;
+		while( sweeps<iters && !_SweepsConverged( sweepRNorm2s , sweepAccuracy , sweepStagnation ) )
+		{
+			sweeps += _solveSlicedSystemGS( UIntPack< FEMSigs ... >() , F , bsData , depth , solution , prolongedSolution , constraints , Dot , std::min< int >( RoundSweeps , iters-sweeps ) , coarseToFine , sliceBlockSize , sorWeights , stats , computeNorms , &sweepRNorm2s , interpolationInfos );
+			systemTime += stats.systemTime , solveTime += stats.solveTime;
+			if( sweeps<=RoundSweeps ) bNorm2 = stats.bNorm2 , inRNorm2 = stats.inRNorm2;
+		}
+		stats.systemTime = systemTime , stats.solveTime = solveTime;
+		if( computeNorms ) stats.bNorm2 = bNorm2 , stats.inRNorm2 = inRNorm2;
+		return sweeps;
+	}
+	// Returns true if the square norms of the residuals before each of the sweeps performed so far show that the relaxation has reduced the residual by the target factor or has stagnated
+	static bool _SweepsConverged( const std::vector< double > &sweepRNorm2s , double sweepAccuracy , double sweepStagnation )
 	{
-		if( sliced ) return _solveSlicedSystemGS( UIntPack< FEMSigs ... >() , F , bsData , depth , solution , prolongedSolution , constraints , Dot , iters , coarseToFine , sliceBlockSize , sorWeights , stats , computeNorms , interpolationInfos );
-		else         return _solveFullSystemGS  ( UIntPack< FEMSigs ... >() , F , bsData , depth , solution , prolongedSolution , constraints , Dot , iters , coarseToFine ,                  sorWeights , stats , computeNorms , interpolationInfos );
+		if( sweepRNorm2s.empty() ) return false;
+		if( sweepAccuracy>0 && sweepRNorm2s.back()<=sweepAccuracy * sweepAccuracy * sweepRNorm2s[0] ) return true;
+		if( sweepStagnation>0 && sweepRNorm2s.size()>1 && sweepRNorm2s.back()>sweepStagnation * sweepStagnation * sweepRNorm2s[ sweepRNorm2s.size()-2 ] ) return true;
+		return false;
 	}
 	template< unsigned int ... FEMSigs , typename T , typename TDotT , typename ... InterpolationInfos >
-	int _solveSystemCG( UIntPack< FEMSigs ... > , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , _SolverStats& stats , bool computeNorms , double cgAccuracy , std::tuple< InterpolationInfos *... > interpolationInfos ) const;
+	int _solveSystemCG( UIntPack< FEMSigs ... > , const typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) prolongedSolution , ConstPointer( T ) constraints , TDotT Dot , int iters , bool coarseToFine , _SolverStats& stats , bool computeNorms , double cgAccuracy , bool pipelinedCG , int cgPreconditioner , std::tuple< InterpolationInfos *... > interpolationInfos ) const;
 	template< unsigned int ... FEMSigs , typename T , typename TDotT , typename ... InterpolationInfos >
-	void _solveRegularMG( UIntPack< FEMSigs ... > , typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) constraints , TDotT Dot , int vCycles , int iters , _SolverStats& stats , bool computeNorms , double cgAccuracy , std::tuple< InterpolationInfos *... > interpolationInfos ) const;
+	void _solveRegularMG( UIntPack< FEMSigs ... > , typename BaseFEMIntegrator::System< UIntPack< FEMSignature< FEMSigs >::Degree ... > >& F , const PointEvaluator< UIntPack< FEMSigs ... > , UIntPack< FEMSignature< FEMSigs >::Degree ... > >& bsData , LocalDepth depth , Pointer( T ) solution , ConstPointer( T ) constraints , TDotT Dot , int vCycles , int iters , _SolverStats& stats , bool computeNorms , double cgAccuracy , bool pipelinedCG , int cgPreconditioner , bool directBaseSolve , double vCycleAccuracy , std::tuple< InterpolationInfos *... > interpolationInfos ) const;
 
 	// Updates the cumulative integral constraints @(depth-1) based on the change in solution coefficients @(depth)
 	template< unsigned int ... FEMSigs , typename T >
@@ -2190,6 +2225,8 @@ protected:
 	template< class C , typename ArrayWrapper , unsigned ... Degrees , unsigned int ... FEMSigs > void _downSample( UIntPack< FEMSigs ... > , typename BaseFEMIntegrator::template RestrictionProlongation< UIntPack< Degrees ... > >& RP , LocalDepth highDepth , ArrayWrapper finerConstraints , Pointer( C ) coarserConstraints ) const;
 	// Up samples coefficients @(depth-1) to coefficients @(depth)
 	template< class C , typename ArrayWrapper , unsigned ... Degrees , unsigned int ... FEMSigs > void   _upSample( UIntPack< FEMSigs ... > , typename BaseFEMIntegrator::template RestrictionProlongation< UIntPack< Degrees ... > >& RP , LocalDepth highDepth , ArrayWrapper coarserCoefficients , Pointer( C ) finerCoefficients ) const;
+	// Up samples coefficients @(depth-1) to coefficients @(depth) for the nodes @(depth) with indices in the range [nBegin,nEnd)
+	template< class C , typename ArrayWrapper , unsigned ... Degrees , unsigned int ... FEMSigs > void   _upSample( UIntPack< FEMSigs ... > , typename BaseFEMIntegrator::template RestrictionProlongation< UIntPack< Degrees ... > >& RP , LocalDepth highDepth , ArrayWrapper coarserCoefficients , Pointer( C ) finerCoefficients , node_index_type nBegin , node_index_type nEnd ) const;
 
 	template< unsigned int ... FEMSigs , typename ValidNodeFunctor >
 	SparseMatrix< Real , matrix_index_type > _downSampleMatrix( UIntPack< FEMSigs ... > , LocalDepth highDepth , ValidNodeFunctor validNodeFunctor ) const;
@@ -2235,6 +2272,10 @@ protected:
 	void _addWeightContribution( Allocator< FEMTreeNode > *nodeAllocator , DensityEstimator< WeightDegree >& densityWeights , FEMTreeNode* node , Point< Real , Dim > position , PointSupportKey< IsotropicUIntPack< Dim , WeightDegree > >& weightKey , Real weight=Real(1.0) );
 	template< unsigned int WeightDegree , class PointSupportKey >
 	Real _getSamplesPerNode( const DensityEstimator< WeightDegree >& densityWeights , const FEMTreeNode* node , Point< Real , Dim > position , PointSupportKey& weightKey ) const;
+	template< unsigned int WeightDegree , class PointSupportKey >
+	void _getSamplesPerNode( const DensityEstimator< WeightDegree >& densityWeights , const FEMTreeNode* node , const Point< Real , Dim > *positions , const unsigned int *indices , unsigned int count , PointSupportKey& weightKey , Real *samplesPerNode ) const;
+	template< unsigned int WeightDegree , class WeightKey >
+	void _getSampleDepthsAndWeights( const DensityEstimator< WeightDegree >& densityWeights , const FEMTreeNode* node , const Point< Real , Dim > *positions , unsigned int count , WeightKey& weightKey , Real *depths , Real *weights ) const;
 	template< unsigned int WeightDegree , class WeightKey >
 	void _getSampleDepthAndWeight( const DensityEstimator< WeightDegree >& densityWeights , const FEMTreeNode* node , Point< Real , Dim > position , WeightKey& weightKey , Real& depth , Real& weight ) const;
 	template< unsigned int WeightDegree , class WeightKey >
@@ -2247,6 +2288,7 @@ protected:
 	template< unsigned int WeightDegree , class V , unsigned int ... DataSigs > Real _nearestMultiSplatPointData( const DensityEstimator< WeightDegree >* densityWeights , FEMTreeNode* node , Point< Real , Dim > point , V v , SparseNodeData< V , UIntPack< DataSigs ... > >& data , PointSupportKey< IsotropicUIntPack< Dim , WeightDegree > >& weightKey , int dim=Dim );
 	template< class V , class Coefficients , unsigned int D , unsigned int ... DataSigs > void _addEvaluation( const Coefficients& coefficients , Point< Real , Dim > p , const PointEvaluator< UIntPack< DataSigs ... > , IsotropicUIntPack< Dim , D > >& pointEvaluator , const ConstPointSupportKey< UIntPack< FEMSignature< DataSigs >::Degree ... > >& dataKey , V &value ) const;
 	template< class V , class Coefficients , unsigned int D , unsigned int ... DataSigs > void _addEvaluation( const Coefficients& coefficients , Point< Real , Dim > p , LocalDepth pointDepth , const PointEvaluator< UIntPack< DataSigs ... > , IsotropicUIntPack< Dim , D > >& pointEvaluator , const ConstPointSupportKey< UIntPack< FEMSignature< DataSigs >::Degree ... > >& dataKey , V &value ) const;
+	template< class V , class Coefficients , unsigned int D , unsigned int ... DataSigs > void _addEvaluations( const Coefficients& coefficients , const Point< Real , Dim > *p , unsigned int count , LocalDepth pointDepth , const PointEvaluator< UIntPack< DataSigs ... > , IsotropicUIntPack< Dim , D > >& pointEvaluator , const ConstPointSupportKey< UIntPack< FEMSignature< DataSigs >::Degree ... > >& dataKey , V *values ) const;
 
 public:
 
@@ -2311,6 +2353,12 @@ protected:
 		typedef DynamicWindow< CumulativeDerivativeValues< double , Dim , PointD > , UIntPack< BSplineSupportSizes< FEMSignature< FEMSigs >::Degree >::SupportSize ... > > CornerStencil;
 		typedef DynamicWindow< CumulativeDerivativeValues< double , Dim , PointD > , UIntPack< ( BSplineSupportSizes< FEMSignature< FEMSigs >::Degree >::BCornerSize + 1 ) ... > > BCornerStencil;
 
+		// The (loop-ordered) indices of the corner stencil entries that are non-zero, for each derivative order
+		template< unsigned int Size >
+		struct StencilSupport{ unsigned int size[PointD+1] , indices[PointD+1][Size]; };
+		typedef StencilSupport< WindowSize< UIntPack< BSplineSupportSizes< FEMSignature< FEMSigs >::Degree >::SupportSize ... > >::Size > CornerSupport;
+		typedef StencilSupport< WindowSize< UIntPack< ( BSplineSupportSizes< FEMSignature< FEMSigs >::Degree >::BCornerSize + 1 ) ... > >::Size > BCornerSupport;
+
 		typedef std::tuple< typename BSplineEvaluationData< FEMSigs >::template      Evaluator< PointD > ... >      Evaluators;
 		typedef std::tuple< typename BSplineEvaluationData< FEMSigs >::template ChildEvaluator< PointD > ... > ChildEvaluators;
 		struct StencilData
@@ -2318,6 +2366,8 @@ protected:
 			CenterStencil ccCenterStencil , pcCenterStencils[CHILDREN];
 			CornerStencil ccCornerStencil[CHILDREN] , pcCornerStencils[CHILDREN][CHILDREN];
 			BCornerStencil ccBCornerStencil[CHILDREN] , pcBCornerStencils[CHILDREN][CHILDREN];
+			CornerSupport ccCornerSupport[CHILDREN] , pcCornerSupports[CHILDREN][CHILDREN];
+			BCornerSupport ccBCornerSupport[CHILDREN] , pcBCornerSupports[CHILDREN][CHILDREN];
 		};
 		Pointer( StencilData ) stencilData;
 		Pointer(      Evaluators )      evaluators;
@@ -2339,6 +2389,24 @@ protected:
 			_setDValues< _PointD , I+1 >( d , fIdx , cIdx , off , pc , dValues );
 		}
 
+		template< unsigned int Size , typename Stencil >
+		static void _SetSupport( StencilSupport< Size > &support , const Stencil &stencil , unsigned int size , const unsigned int *indices )
+		{
+			// The number of cumulative derivatives up to order dd is (Dim+dd choose dd)
+			unsigned int derivativeSize = 1;
+			for( unsigned int dd=0 ; dd<=PointD ; dd++ )
+			{
+				if( dd ) derivativeSize = derivativeSize * ( Dim + dd ) / dd;
+				support.size[dd] = 0;
+				for( unsigned int i=0 ; i<size ; i++ )
+				{
+					bool nonZero = false;
+					for( unsigned int j=0 ; j<derivativeSize ; j++ ) nonZero |= stencil().data[ indices[i] ][j]!=0;
+					if( nonZero ) support.indices[dd][ support.size[dd]++ ] = indices[i];
+				}
+			}
+		}
+
 		template< unsigned int I=0 > typename std::enable_if< I==Dim >::type _setEvaluators( unsigned int maxDepth ){ }
 		template< unsigned int I=0 > typename std::enable_if< I< Dim >::type _setEvaluators( unsigned int maxDepth )
 		{
@@ -2812,13 +2880,20 @@ public:
 		_IterFunction iters;
 		int vCycles;
 		double cgAccuracy;
+		bool pipelinedCG;
+		int cgPreconditioner;
+		bool directBaseSolve;
+		// If positive, the Gauss-Seidel sweeps at a depth stop once the residual has been reduced by the accuracy factor, or once a sweep reduces it by less than the stagnation factor
+		double sweepAccuracy , sweepStagnation;
+		// If positive, the v-cycles stop once the residual at the finest depth, relative to the constraints, falls below the accuracy
+		double vCycleAccuracy;
 		bool clearSolution;
 		int baseVCycles;
 		// What to output
 		bool verbose , showResidual;
 		int showGlobalResidual;
 
-		SolverInfo( void ) : cgDepth(0) , wCycle(false) , cascadic(true) , iters(1) , vCycles(1) , cgAccuracy(0.) , verbose(false) , showResidual(false) , showGlobalResidual(SHOW_GLOBAL_RESIDUAL_NONE) , sliceBlockSize(1) , sorRestrictionFunction( []( Real , Real ){ return (Real)1; } ) , sorProlongationFunction( []( Real , Real ){ return (Real)1; } ) , useSupportWeights( false ) , useProlongationSupportWeights( false ) , baseVCycles(1) , clearSolution(true) { }
+		SolverInfo( void ) : cgDepth(0) , wCycle(false) , cascadic(true) , iters(1) , vCycles(1) , cgAccuracy(0.) , pipelinedCG(false) , cgPreconditioner(CG_PRECONDITIONER_NONE) , directBaseSolve(false) , sweepAccuracy(0.) , sweepStagnation(0.) , vCycleAccuracy(0.) , verbose(false) , showResidual(false) , showGlobalResidual(SHOW_GLOBAL_RESIDUAL_NONE) , sliceBlockSize(1) , sorRestrictionFunction( []( Real , Real ){ return (Real)1; } ) , sorProlongationFunction( []( Real , Real ){ return (Real)1; } ) , useSupportWeights( false ) , useProlongationSupportWeights( false ) , baseVCycles(1) , clearSolution(true) { }
 	};
 	// Solve the linear system
 	// There are several depths playing into the solver:
@@ -30,6 +30,7 @@ DAMAGE.
 #define MERGE_PLY_CLIENT_SERVER_INCLUDED
 
 #include <string>
+#include <filesystem>
 #include "Socket.h"
 #include "MyMiscellany.h"
 #include "CmdLineParser.h"
@@ -42,6 +43,9 @@ namespace MergePlyClientServer
 		std::vector< PlyProperty > auxProperties;
 		size_t bufferSize;
 		bool verbose;
+		// If set, the clients write their slabs directly into the (pre-sized) output file
+		// [NOTE] This requires that the output file be accessible to the clients
+		bool direct;
 
 		ClientMergePlyInfo( void );
 		ClientMergePlyInfo( BinaryStream &stream );
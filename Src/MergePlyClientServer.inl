@@ -55,12 +55,98 @@ inline void _Copy( FILE *target , FILE *source , size_t sz , size_t bufferSize=1
 	DeletePointer( buffer );
 }
 
+inline void _Seek( FILE *fp , size_t offset , int origin=SEEK_SET )
+{
+#if defined( _WIN32 ) || defined( _WIN64 )
+	if( _fseeki64( fp , (long long)offset , origin ) ) ERROR_OUT( "Failed to seek to: " , offset );
+#else // !_WIN32 && !_WIN64
+	if( fseeko( fp , (off_t)offset , origin ) ) ERROR_OUT( "Failed to seek to: " , offset );
+#endif // _WIN32 || _WIN64
+}
+
+inline size_t _Tell( FILE *fp )
+{
+#if defined( _WIN32 ) || defined( _WIN64 )
+	return (size_t)_ftelli64( fp );
+#else // !_WIN32 && !_WIN64
+	return (size_t)ftello( fp );
+#endif // _WIN32 || _WIN64
+}
+
+// Opens the file and positions the file pointer at the prescribed offset
+inline FILE *_Open( std::string fileName , const char *mode , size_t offset , size_t bufferSize )
+{
+	FILE *fp = fopen( fileName.c_str() , mode );
+	if( !fp ) ERROR_OUT( "Failed to open file: " , fileName );
+	setvbuf( fp , NULL , _IOFBF , bufferSize );
+	_Seek( fp , offset );
+	return fp;
+}
+
+// The output file name used by PLY::WriteHeader
+inline std::string _PlyFileName( std::string fileName )
+{
+	if( fileName.length()<4 || fileName.substr( fileName.length()-4 )!=".ply" ) fileName += ".ply";
+	return fileName;
+}
+
+// Reads the polygons (in binary format, with an int-valued index count), offsets the indices, and writes them out
+template< typename InIndex , typename OutIndex >
+void _OffsetPolygons( FILE *target , FILE *source , size_t fNum , size_t offset )
+{
+	std::vector< InIndex > inIndices( 64 );
+	std::vector< OutIndex > outIndices( 64 );
+	for( size_t i=0 ; i<fNum ; i++ )
+	{
+		int n;
+		if( fread( &n , sizeof(int) , 1 , source )!=1 ) ERROR_OUT( "Failed to read polygon size" );
+		if( n>(int)inIndices.size() ) inIndices.resize( n ) , outIndices.resize( n );
+		if( fread( &inIndices[0] , sizeof(InIndex) , n , source )!=n ) ERROR_OUT( "Failed to read polygon indices" );
+		for( int j=0 ; j<n ; j++ ) outIndices[j] = (OutIndex)( inIndices[j] + offset );
+		if( fwrite( &n , sizeof(int) , 1 , target )!=1 ) ERROR_OUT( "Failed to write polygon size" );
+		if( fwrite( &outIndices[0] , sizeof(OutIndex) , n , target )!=n ) ERROR_OUT( "Failed to write polygon indices" );
+	}
+}
+
+template< typename OutIndex >
+void _OffsetPolygons( FILE *target , FILE *source , int inIndexType , size_t fNum , size_t offset )
+{
+	switch( inIndexType )
+	{
+		case PLY_INT:       case PLY_INT_32:  _OffsetPolygons<                int , OutIndex >( target , source , fNum , offset ) ; break;
+		case PLY_UINT:      case PLY_UINT_32: _OffsetPolygons<       unsigned int , OutIndex >( target , source , fNum , offset ) ; break;
+		case PLY_LONGLONG:  case PLY_INT_64:  _OffsetPolygons<          long long , OutIndex >( target , source , fNum , offset ) ; break;
+		case PLY_ULONGLONG: case PLY_UINT_64: _OffsetPolygons< unsigned long long , OutIndex >( target , source , fNum , offset ) ; break;
+		default: ERROR_OUT( "Unsupported polygon index type: " , PlyTypes[ inIndexType ] );
+	}
+}
+
+inline void _OffsetPolygons( FILE *target , FILE *source , _IndexType outIndexType , int inIndexType , size_t fNum , size_t offset )
+{
+	switch( outIndexType )
+	{
+		case INT:       _OffsetPolygons<          int >( target , source , inIndexType , fNum , offset ) ; break;
+		case U_INT:     _OffsetPolygons< unsigned int >( target , source , inIndexType , fNum , offset ) ; break;
+		case LONG_LONG: _OffsetPolygons<    long long >( target , source , inIndexType , fNum , offset ) ; break;
+		default: ERROR_OUT( "Unrecognized output index type" );
+	}
+}
+
+inline size_t _IndexSize( _IndexType idxType )
+{
+	switch( idxType )
+	{
+		case INT:       return sizeof(          int );
+		case U_INT:     return sizeof( unsigned int );
+		case LONG_LONG: return sizeof(    long long );
+		default: ERROR_OUT( "Unrecognized output index type" );
+	}
+	return 0;
+}
+
 template< typename Index , typename Factory >
 void _OffsetPolygons( const Factory &factory , std::string in , std::string out , size_t offset , Profiler &profiler )
 {
-#if 1
-//	PlyProperty faceProperty( "vertex_indices" , PLY::DefaultFileType< Index >() , PLY::DefaultFileType< Index >() , sizeof(int) , 1 , PLY::DefaultFileType< int >() , PLY::DefaultFileType< int >() , 0 );
-
 	int ft;
 	std::vector< std::string > comments;
 
@@ -74,13 +160,7 @@ void _OffsetPolygons( const Factory &factory , std::string in , std::string out
 		for( unsigned int i=0 ; i<factory.plyWriteNum() ; i++ ) sizeOnDisk += ply_type_size[ factory.plyWriteProperty(i).external_type ];
 
 	// Skip the vertices
-	{
-#if defined( _WIN32 ) || defined( _WIN64 )
-		_fseeki64( inPly->fp , sizeOnDisk * std::get<1>( _elems[0] ) , SEEK_CUR );
-#else // !_WIN32 && !_WIN64
-		fseek( inPly->fp , sizeOnDisk * std::get<1>( _elems[0] ) , SEEK_CUR );
-#endif // _WIN32 || _WIN64
-	}
+	_Seek( inPly->fp , sizeOnDisk * std::get<1>( _elems[0] ) , SEEK_CUR );
 
 	std::vector< std::tuple< std::string , size_t , std::vector< PlyProperty > > > elems(1);
 	std::get<0>( elems[0] ) = std::string( "face" );
@@ -91,89 +171,77 @@ void _OffsetPolygons( const Factory &factory , std::string in , std::string out
 	PlyFile *outPly = PLY::WriteHeader( out , ft , elems , comments );
 
 	// Read and offset the polygons
-	{
-		int maxIndices = 64;
-		Index *faceIndices = (Index*)malloc( sizeof(Index) * maxIndices );
+	_OffsetPolygons< Index >( outPly->fp , inPly->fp , std::get<2>( _elems[1] )[0].external_type , std::get<1>( _elems[1] ) , offset );
+	profiler.update();
 
-		auto ReadPolygon = [&]( FILE *fp )
-		{
-			int n;
-			if( fread( &n , sizeof(int) , 1 , fp )!=1 ) ERROR_OUT( "Failed to read polygon size" );
-			if( n>maxIndices )
-			{
-				maxIndices = n;
-				faceIndices = (Index*)realloc( faceIndices , sizeof(Index) * maxIndices );
-			}
-			if( fread( faceIndices , sizeof(Index) , n , fp )!=n ) ERROR_OUT( "Failed to read polygon indices" );
-			return n;
-		};
-
-		auto WritePolygon = [&]( FILE *fp , int n )
-		{
-			fwrite( &n , sizeof(int) , 1 , fp );
-			fwrite( faceIndices , sizeof(Index) , n , fp );
-		};
-
-		for( unsigned int j=0 ; j<std::get<2>( _elems[1] ).size() ; j++ ) inPly->get_property( std::get<0>( _elems[1] ) , &std::get<2>( _elems[1] )[j] );
-		outPly->put_element_setup( std::string( "face" ) );
-
-		for( size_t i=0 ; i<std::get<1>( _elems[1] ) ; i++ )
-		{
-			int n = ReadPolygon( inPly->fp );
-			for( int j=0 ; j<n ; j++ ) faceIndices[j] += (Index)offset;
-			WritePolygon( outPly->fp , n );
-		}
-
-		profiler.update();
-
-		delete[] faceIndices;
-	}
 	delete inPly;
 	delete outPly;
-#else
-	typedef typename Factory::VertexType Vertex;
-	std::vector< Vertex > vertices;
-	std::vector< std::vector< Index > > polygons;
-
-	int ft;
-	std::vector< std::string > comments;
+}
 
-	PLY::ReadPolygons< Factory , Index >( in , factory , vertices , polygons , ft , comments );
-	std::vector< std::tuple< std::string , size_t , std::vector< PlyProperty > > > elems(1);
-	std::get<0>( elems[0] ) = std::string( "face" );
-	std::get<1>( elems[0] ) = polygons.size();
-	std::get<2>( elems[0] ).resize(1);
-	std::get<2>( elems[0] )[0] = PLY::Face< Index >::Properties[0];
+// The description of the part of the merged file that a client is responsible for writing:
+// -- the interior vertices of the slab (those not shared with the neighboring slabs), copied verbatim
+// -- the faces of the slab, with indices offset to the merged vertex indexing
+struct _DirectMergeJob
+{
+	std::string in , out;
+	_IndexType idxType;
+	int inIndexType;
+	size_t vertexOffset;
+	size_t vertexBytes , vertexSource , vertexTarget;
+	size_t fNum , faceSource , faceTarget;
 
-	PlyFile *ply = PLY::WriteHeader( out , ft , elems , comments );
+	_DirectMergeJob( void ) : idxType(INT) , inIndexType(PLY_INT) , vertexOffset(0) , vertexBytes(0) , vertexSource(0) , vertexTarget(0) , fNum(0) , faceSource(0) , faceTarget(0) {}
 
+	void write( BinaryStream &stream ) const
 	{
-		PLY::Face< Index > face;
-		unsigned int maxFaceVerts=3;
-		face.nr_vertices = 3;
-		face.vertices = new Index[ face.nr_vertices ];
+		stream.write( in );
+		stream.write( out );
+		stream.write( idxType );
+		stream.write( inIndexType );
+		stream.write( vertexOffset );
+		stream.write( vertexBytes );
+		stream.write( vertexSource );
+		stream.write( vertexTarget );
+		stream.write( fNum );
+		stream.write( faceSource );
+		stream.write( faceTarget );
+	}
 
-		ply->put_element_setup( std::string( "face" ) );
-		for( size_t i=0 ; i<polygons.size() ; i++ )
-		{
-			if( polygons[i].size()>maxFaceVerts )
-			{
-				delete[] face.vertices;
-				maxFaceVerts = (unsigned int)polygons[i].size();
-				face.vertices=new Index[ maxFaceVerts ];
-			}
-			face.nr_vertices = (unsigned int)polygons[i].size();
-			for( size_t j=0 ; j<face.nr_vertices ; j++ ) face.vertices[j] = (Index)(polygons[i][j] + offset);
-			ply->put_element( (void *)&face );
-		}
+	void read( BinaryStream &stream )
+	{
+		if( !stream.read( in ) ) ERROR_OUT( "Failed to read input file name" );
+		if( !stream.read( out ) ) ERROR_OUT( "Failed to read output file name" );
+		if( !stream.read( idxType ) ) ERROR_OUT( "Failed to read output index type" );
+		if( !stream.read( inIndexType ) ) ERROR_OUT( "Failed to read input index type" );
+		if( !stream.read( vertexOffset ) ) ERROR_OUT( "Failed to read vertex offset" );
+		if( !stream.read( vertexBytes ) ) ERROR_OUT( "Failed to read vertex bytes" );
+		if( !stream.read( vertexSource ) ) ERROR_OUT( "Failed to read vertex source offset" );
+		if( !stream.read( vertexTarget ) ) ERROR_OUT( "Failed to read vertex target offset" );
+		if( !stream.read( fNum ) ) ERROR_OUT( "Failed to read face count" );
+		if( !stream.read( faceSource ) ) ERROR_OUT( "Failed to read face source offset" );
+		if( !stream.read( faceTarget ) ) ERROR_OUT( "Failed to read face target offset" );
+	}
 
-		profiler.update();
+	void copyVertices( size_t bufferSize ) const
+	{
+		if( !vertexBytes ) return;
+		FILE *source = _Open( in , "rb" , vertexSource , bufferSize );
+		FILE *target = _Open( out , "r+b" , vertexTarget , bufferSize );
+		_Copy( target , source , vertexBytes , bufferSize );
+		fclose( source );
+		fclose( target );
+	}
 
-		delete[] face.vertices;
+	void offsetPolygons( size_t bufferSize ) const
+	{
+		if( !fNum ) return;
+		FILE *source = _Open( in , "rb" , faceSource , bufferSize );
+		FILE *target = _Open( out , "r+b" , faceTarget , bufferSize );
+		_OffsetPolygons( target , source , idxType , inIndexType , fNum , vertexOffset );
+		fclose( source );
+		fclose( target );
 	}
-	delete ply;
-#endif
-}
+};
 
 
 ////////////
@@ -207,10 +275,18 @@ void _RunServer
 	auto InFile = [&]( unsigned int idx ){ return ClientFile( inDir , header , idx ); };
 	auto TempPolygonFile = [&]( unsigned int idx ){ return ClientFile( tempDir , header + std::string( ".polygons" ) , idx ); };
 
+	size_t sizeOnDisk = 0;
+	if( factory.isStaticallyAllocated() )
+		for( unsigned int i=0 ; i<factory.plyWriteNum() ; i++ ) sizeOnDisk += ply_type_size[ factory.plyStaticWriteProperty(i).external_type ];
+	else
+		for( unsigned int i=0 ; i<factory.plyWriteNum() ; i++ ) sizeOnDisk += ply_type_size[ factory.plyWriteProperty(i).external_type ];
+
 	profiler.reset();
 
 	// Get the number of vertices and polygons per file
-	std::vector< size_t > vNum( sharedVertexCounts.size()+1 ) , fNum( sharedVertexCounts.size()+1 ) , offsets( sharedVertexCounts.size()+1 );
+	// [NOTE] For the direct merge we also need to know where the data starts and how many indices are stored in the polygons
+	std::vector< size_t > vNum( sharedVertexCounts.size()+1 ) , fNum( sharedVertexCounts.size()+1 ) , offsets( sharedVertexCounts.size()+1 ) , dataStarts( sharedVertexCounts.size()+1 ) , iNum( sharedVertexCounts.size()+1 );
+	std::vector< int > inIndexTypes( sharedVertexCounts.size()+1 );
 	{
 		for( unsigned int i=0 ; i<=sharedVertexCounts.size() ; i++ )
 		{
@@ -218,13 +294,29 @@ void _RunServer
 			int ft;
 			std::vector< std::tuple< std::string , size_t , std::vector< PlyProperty > > > elems;
 			PlyFile *ply = PLY::ReadHeader( inFile , ft , elems );
+			dataStarts[i] = _Tell( ply->fp );
 			delete ply;
 			bool foundVertices = false , foundFaces = false;
 			for( unsigned int j=0 ; j<elems.size() ; j++ )
 				if     ( std::get<0>( elems[j] )==std::string( "vertex" ) ) foundVertices = true , vNum[i] = std::get<1>( elems[j] );
-				else if( std::get<0>( elems[j] )==std::string( "face"   ) ) foundFaces    = true , fNum[i] = std::get<1>( elems[j] );
+				else if( std::get<0>( elems[j] )==std::string( "face"   ) )
+				{
+					foundFaces = true , fNum[i] = std::get<1>( elems[j] );
+					if( std::get<2>( elems[j] ).size()!=1 || !std::get<2>( elems[j] )[0].is_list ) ERROR_OUT( "Expected a single list property for faces" );
+					if( ply_type_size[ std::get<2>( elems[j] )[0].count_external ]!=sizeof(int) ) ERROR_OUT( "Expected int-sized polygon sizes" );
+					inIndexTypes[i] = std::get<2>( elems[j] )[0].external_type;
+				}
 			if( !foundVertices ) ERROR_OUT( "Could not find vertices" );
 			if( !foundFaces ) ERROR_OUT( "Could not find faces" );
+			if( clientMergePlyInfo.direct )
+			{
+				size_t fileSize = (size_t)std::filesystem::file_size( inFile );
+				if( fileSize<dataStarts[i] + vNum[i] * sizeOnDisk + fNum[i] * sizeof(int) ) ERROR_OUT( "File too small: " , inFile );
+				size_t faceBytes = fileSize - dataStarts[i] - vNum[i] * sizeOnDisk - fNum[i] * sizeof(int);
+				size_t indexSize = ply_type_size[ inIndexTypes[i] ];
+				if( faceBytes%indexSize ) ERROR_OUT( "Unexpected polygon data size: " , faceBytes , " % " , indexSize );
+				iNum[i] = faceBytes / indexSize;
+			}
 			profiler.update();
 		}
 		offsets[0] = 0;
@@ -246,24 +338,6 @@ void _RunServer
 
 	if( clientMergePlyInfo.verbose ) std::cout << "Got mesh info: " << profiler(true) << std::endl;
 
-
-	for( unsigned int i=0 ; i<clientSockets.size() ; i++ )
-	{
-		SocketStream clientStream( clientSockets[i] );
-		clientStream.write( InFile(i) );
-		clientStream.write( TempPolygonFile(i) );
-		clientStream.write( idxType );
-		clientStream.write( offsets[i] );
-
-	}
-	for( unsigned int i=0 ; i<clientSockets.size() ; i++ )
-	{
-		unsigned char done;
-		SocketStream clientStream( clientSockets[i] );
-		clientStream.read( done );
-	}
-
-	profiler.reset();
 	std::vector< std::tuple< std::string , size_t , std::vector< PlyProperty > > > elems(2);
 	{
 		std::get<0>( elems[0] ) = std::string( "vertex" );
@@ -285,102 +359,194 @@ void _RunServer
 			default: ERROR_OUT( "Unrecognized output type" );
 		}
 	}
-	PlyFile *outPly = PLY::WriteHeader( out , PLY_BINARY_NATIVE , elems );
 
-	// Write out the (merged) vertices
-	{
-		Pointer( char ) vBuffer = NewPointer< char >( factory.bufferSize() );
+	Pointer( char ) vBuffer = NewPointer< char >( factory.bufferSize() );
 
-		outPly->put_element_setup( std::string( "vertex" ) );
+	auto ReadVertex = [&]( PlyFile *ply , Vertex &v )
+	{
+		if( factory.isStaticallyAllocated() ) ply->get_element( (void*)&v );
+		else
+		{
+			ply->get_element( PointerAddress( vBuffer ) );
+			factory.fromBuffer( vBuffer , v );
+		}
+	};
 
-		size_t sizeOnDisk = 0;
-		if( factory.isStaticallyAllocated() )
-			for( unsigned int i=0 ; i<factory.plyWriteNum() ; i++ ) sizeOnDisk += ply_type_size[ factory.plyStaticWriteProperty(i).external_type ];
+	auto WriteVertex = [&]( PlyFile *ply , const Vertex &v )
+	{
+		if( factory.isStaticallyAllocated() ) ply->put_element( (void*)&v );
 		else
-			for( unsigned int i=0 ; i<factory.plyWriteNum() ; i++ ) sizeOnDisk += ply_type_size[ factory.plyWriteProperty(i).external_type ];
+		{
+			factory.toBuffer( v , vBuffer );
+			ply->put_element( PointerAddress( vBuffer ) );
+		}
+	};
 
-		std::vector< Vertex > sharedVertices;
-		for( unsigned int i=0 ; i<=sharedVertexCounts.size() ; i++ )
+	if( clientMergePlyInfo.direct )
+	{
+		profiler.reset();
+		PlyFile *outPly = PLY::WriteHeader( out , PLY_BINARY_NATIVE , elems );
+		std::string outFileName = _PlyFileName( out );
+		size_t headerSize = _Tell( outPly->fp );
+
+		// Compute where the polygons of each slab start in the merged file
+		std::vector< size_t > faceTargets( sharedVertexCounts.size()+2 );
+		faceTargets[0] = headerSize + std::get<1>( elems[0] ) * sizeOnDisk;
+		for( unsigned int i=0 ; i<=sharedVertexCounts.size() ; i++ ) faceTargets[i+1] = faceTargets[i] + fNum[i] * sizeof(int) + iNum[i] * _IndexSize( idxType );
+
+		// Pre-size the merged file so that the clients can write their parts concurrently
+		fflush( outPly->fp );
+		std::filesystem::resize_file( outFileName , faceTargets.back() );
+
+		for( unsigned int i=0 ; i<clientSockets.size() ; i++ )
 		{
-			std::vector< std::tuple< std::string , size_t , std::vector< PlyProperty > > > _elems;
-			int ft;
-			PlyFile *inPly = PLY::ReadHeader( InFile(i) , ft , _elems );
+			size_t startShared = i>0 ? sharedVertexCounts[i-1] : 0 , endShared = i<sharedVertexCounts.size() ? sharedVertexCounts[i] : 0;
+			if( startShared+endShared>vNum[i] ) ERROR_OUT( "More shared vertices than vertices: " , startShared , " + " , endShared , " > " , vNum[i] );
+
+			_DirectMergeJob job;
+			job.in = InFile(i);
+			job.out = outFileName;
+			job.idxType = idxType;
+			job.inIndexType = inIndexTypes[i];
+			job.vertexOffset = offsets[i];
+			job.vertexBytes = ( vNum[i] - startShared - endShared ) * sizeOnDisk;
+			job.vertexSource = dataStarts[i] + startShared * sizeOnDisk;
+			job.vertexTarget = headerSize + ( offsets[i] + startShared ) * sizeOnDisk;
+			job.fNum = fNum[i];
+			job.faceSource = dataStarts[i] + vNum[i] * sizeOnDisk;
+			job.faceTarget = faceTargets[i];
+
+			SocketStream clientStream( clientSockets[i] );
+			job.write( clientStream );
+		}
+
+		// While the clients copy the interior vertices and offset the polygons, merge the shared vertices
+		{
+			outPly->put_element_setup( std::string( "vertex" ) );
+			std::vector< Vertex > backVertices , frontVertices;
+			for( unsigned int i=0 ; i<sharedVertexCounts.size() ; i++ ) if( sharedVertexCounts[i] )
+			{
+				backVertices.resize( sharedVertexCounts[i] , factory() );
+				frontVertices.resize( sharedVertexCounts[i] , factory() );
 
-			for( unsigned int j=0 ; j<std::get<2>( elems[0] ).size() ; j++ ) inPly->get_property( std::get<0>( elems[0] ) , &std::get<2>( elems[0] )[j] );
+				auto ReadVertices = [&]( std::string fileName , size_t skip , std::vector< Vertex > &vertices )
+				{
+					std::vector< std::tuple< std::string , size_t , std::vector< PlyProperty > > > _elems;
+					int ft;
+					PlyFile *inPly = PLY::ReadHeader( fileName , ft , _elems );
+					for( unsigned int j=0 ; j<std::get<2>( elems[0] ).size() ; j++ ) inPly->get_property( std::get<0>( elems[0] ) , &std::get<2>( elems[0] )[j] );
+					_Seek( inPly->fp , skip * sizeOnDisk , SEEK_CUR );
+					for( unsigned int j=0 ; j<vertices.size() ; j++ ) ReadVertex( inPly , vertices[j] );
+					delete inPly;
+				};
+
+				// The end vertices of the i-th slab are the start vertices of the (i+1)-st
+				ReadVertices( InFile(i+0) , vNum[i]-sharedVertexCounts[i] , backVertices );
+				ReadVertices( InFile(i+1) , 0 , frontVertices );
+
+				_Seek( outPly->fp , headerSize + offsets[i+1] * sizeOnDisk );
+				for( unsigned int j=0 ; j<sharedVertexCounts[i] ; j++ ) WriteVertex( outPly , ( backVertices[j] + frontVertices[j] ) / (Real)2. );
+				profiler.update();
+			}
+		}
 
-			// Merge the start vertices
-			Vertex v = factory();
-			for( unsigned int j=0 ; j<sharedVertices.size() ; j++ )
+		for( unsigned int i=0 ; i<clientSockets.size() ; i++ )
+		{
+			unsigned char done;
+			SocketStream clientStream( clientSockets[i] );
+			clientStream.read( done );
+		}
+		delete outPly;
+		if( clientMergePlyInfo.verbose ) std::cout << "Merged slabs: " << profiler(true) << std::endl;
+	}
+	else
+	{
+		for( unsigned int i=0 ; i<clientSockets.size() ; i++ )
+		{
+			SocketStream clientStream( clientSockets[i] );
+			clientStream.write( InFile(i) );
+			clientStream.write( TempPolygonFile(i) );
+			clientStream.write( idxType );
+			clientStream.write( offsets[i] );
+
+		}
+		for( unsigned int i=0 ; i<clientSockets.size() ; i++ )
+		{
+			unsigned char done;
+			SocketStream clientStream( clientSockets[i] );
+			clientStream.read( done );
+		}
+
+		profiler.reset();
+		PlyFile *outPly = PLY::WriteHeader( out , PLY_BINARY_NATIVE , elems );
+
+		// Write out the (merged) vertices
+		{
+			outPly->put_element_setup( std::string( "vertex" ) );
+
+			std::vector< Vertex > sharedVertices;
+			for( unsigned int i=0 ; i<=sharedVertexCounts.size() ; i++ )
 			{
-				if( factory.isStaticallyAllocated() )
+				std::vector< std::tuple< std::string , size_t , std::vector< PlyProperty > > > _elems;
+				int ft;
+				PlyFile *inPly = PLY::ReadHeader( InFile(i) , ft , _elems );
+
+				for( unsigned int j=0 ; j<std::get<2>( elems[0] ).size() ; j++ ) inPly->get_property( std::get<0>( elems[0] ) , &std::get<2>( elems[0] )[j] );
+
+				// Merge the start vertices
+				Vertex v = factory();
+				for( unsigned int j=0 ; j<sharedVertices.size() ; j++ )
 				{
-					inPly->get_element( &v );
+					ReadVertex( inPly , v );
 					sharedVertices[j] = ( sharedVertices[j] + v ) / (Real)2.;
-					outPly->put_element( (void*)&sharedVertices[j] );
+					WriteVertex( outPly , sharedVertices[j] );
 				}
-				else
+
+				// Copy the interior vertices
 				{
-					inPly->get_element( PointerAddress( vBuffer ) );
-					factory.fromBuffer( vBuffer , v );
-					sharedVertices[j] = ( sharedVertices[j] + v ) / (Real)2.;
-					factory.toBuffer( sharedVertices[j] , vBuffer );
-					outPly->put_element( PointerAddress( vBuffer ) );
+					size_t vNum = std::get<1>( _elems[0] ) - sharedVertices.size();
+					if( i<sharedVertexCounts.size() ) vNum -= sharedVertexCounts[i];
+					_Copy( outPly->fp , inPly->fp , vNum*sizeOnDisk , clientMergePlyInfo.bufferSize );
 				}
-			}
 
-			// Copy the interior vertices
-			{
-				size_t vNum = std::get<1>( _elems[0] ) - sharedVertices.size();
-				if( i<sharedVertexCounts.size() ) vNum -= sharedVertexCounts[i];
-				_Copy( outPly->fp , inPly->fp , vNum*sizeOnDisk , clientMergePlyInfo.bufferSize );
+				// Buffer the end vertices
+				if( i<sharedVertexCounts.size() )
+				{
+					sharedVertices.resize( sharedVertexCounts[i] , factory() );
+					for( unsigned int j=0 ; j<sharedVertices.size() ; j++ ) ReadVertex( inPly , sharedVertices[j] );
+				}
+				profiler.update();
+
+				delete inPly;
 			}
+			if( clientMergePlyInfo.verbose ) std::cout << "Merged vertices: " << profiler(true) << std::endl;
+		}
 
-			// Buffer the end vertices
-			if( i<sharedVertexCounts.size() )
+		profiler.reset();
+		// Write out the polygons
+		{
+			outPly->put_element_setup( std::string( "face" ) );
+			for( unsigned int i=0 ; i<=sharedVertexCounts.size() ; i++ )
 			{
-				sharedVertices.resize( sharedVertexCounts[i] , factory() );
+				std::vector< std::tuple< std::string , size_t , std::vector< PlyProperty > > > _elems;
+				int ft;
+				PlyFile *inPly = PLY::ReadHeader( TempPolygonFile(i) , ft , _elems );
 
-				for( unsigned int j=0 ; j<sharedVertices.size() ; j++ )
-				{
-					if( factory.isStaticallyAllocated() ) inPly->get_element( (void*)&sharedVertices[j] );
-					else
-					{
-						inPly->get_element( PointerAddress( vBuffer ) );
-						factory.fromBuffer( vBuffer , sharedVertices[j] );
-					}
-				}
+				_Copy( outPly->fp , inPly->fp , -1 , clientMergePlyInfo.bufferSize );
+				profiler.update();
+				delete inPly;
 			}
-			profiler.update();
-
-			delete inPly;
+			if( clientMergePlyInfo.verbose ) std::cout << "Merged polygons: " << profiler(true) << std::endl;
 		}
-		DeletePointer( vBuffer );
-		if( clientMergePlyInfo.verbose ) std::cout << "Merged vertices: " << profiler(true) << std::endl;
-	}
+		delete outPly;
 
-	profiler.reset();
-	// Write out the polygons
-	{
-		outPly->put_element_setup( std::string( "face" ) );
 		for( unsigned int i=0 ; i<=sharedVertexCounts.size() ; i++ )
 		{
-			std::vector< std::tuple< std::string , size_t , std::vector< PlyProperty > > > _elems;
-			int ft;
-			PlyFile *inPly = PLY::ReadHeader( TempPolygonFile(i) , ft , _elems );
-
-			_Copy( outPly->fp , inPly->fp , -1 , clientMergePlyInfo.bufferSize );
-			profiler.update();
-			delete inPly;
+			std::string fileName = TempPolygonFile(i);
+			std::remove( fileName.c_str() );
 		}
-		if( clientMergePlyInfo.verbose ) std::cout << "Merged polygons: " << profiler(true) << std::endl;
-	}
-	delete outPly;
-
-	for( unsigned int i=0 ; i<=sharedVertexCounts.size() ; i++ )
-	{
-		std::string fileName = TempPolygonFile(i);
-		std::remove( fileName.c_str() );
 	}
+	DeletePointer( vBuffer );
 }
 
 template< typename Real , unsigned int Dim >
@@ -435,6 +601,32 @@ void _RunClients
 {
 	Profiler profiler( sampleMS );
 
+	if( clientMergePlyInfo.direct )
+	{
+		std::vector< _DirectMergeJob > jobs( serverSockets.size() );
+		for( unsigned int c=0 ; c<serverSockets.size() ; c++ )
+		{
+			SocketStream socketStream( serverSockets[c] );
+			jobs[c].read( socketStream );
+		}
+
+		// Copy the vertices and offset the polygons of all the slabs in parallel
+		ThreadPool::Parallel_for( 0 , 2*jobs.size() , [&]( unsigned int , size_t i )
+		{
+			if( i&1 ) jobs[i>>1].offsetPolygons( clientMergePlyInfo.bufferSize );
+			else      jobs[i>>1].copyVertices  ( clientMergePlyInfo.bufferSize );
+		} , ThreadPool::DYNAMIC , 1 );
+		profiler.update();
+
+		for( unsigned int c=0 ; c<serverSockets.size() ; c++ )
+		{
+			char done = 1;
+			SocketStream( serverSockets[c] ).write( done );
+		}
+		if( clientMergePlyInfo.verbose ) std::cout << "Wrote slabs: " << profiler(true) << std::endl;
+		return;
+	}
+
 	for( unsigned int c=0 ; c<serverSockets.size() ; c++ )
 	{
 		SocketStream socketStream( serverSockets[c] );
@@ -490,7 +682,7 @@ void RunClients( std::vector< Socket > &serverSockets , unsigned int sampleMS )
 /////////////////////////
 // ClientPartitionInfo //
 /////////////////////////
-ClientMergePlyInfo::ClientMergePlyInfo( void ){}
+ClientMergePlyInfo::ClientMergePlyInfo( void ) : direct(false){}
 
 ClientMergePlyInfo::ClientMergePlyInfo( BinaryStream &stream )
 {
@@ -510,6 +702,7 @@ ClientMergePlyInfo::ClientMergePlyInfo( BinaryStream &stream )
 		for( size_t i=0 ; i<sz ; i++ ) auxProperties[i].read( stream );
 	}
 	if( !ReadBool( verbose ) ) ERROR_OUT( "Failed to read verbose flag" );
+	if( !ReadBool( direct ) ) ERROR_OUT( "Failed to read direct flag" );
 }
 
 void ClientMergePlyInfo::write( BinaryStream &stream ) const
@@ -527,4 +720,5 @@ void ClientMergePlyInfo::write( BinaryStream &stream ) const
 		for( size_t j=0 ; j<sz ; j++ ) auxProperties[j].write( stream );
 	}
 	WriteBool( verbose );
+	WriteBool( direct );
 }
@@ -97,6 +97,28 @@ namespace PLY
 	template< typename VertexFactory , typename Index , bool UseCharIndex=false >
 	void WritePolygons( std::string fileName , const VertexFactory &vFactory , const std::vector< typename VertexFactory::VertexType > &vertices , const std::vector< std::vector< Index > > &polygons , int file_type , const std::vector< std::string > &comments );
 
+	// PLY streaming write mesh functionality (binary files only)
+	// Vertices are written to the file as they are generated, the polygons are appended once the vertices are complete, and the element counts are patched into the header
+	template< typename VertexFactory , typename Index , typename OutputIndex=int , bool UseCharIndex=false >
+	struct StreamingPolygonWriter : public OutputDataStream< typename VertexFactory::VertexType >
+	{
+		StreamingPolygonWriter( std::string fileName , const VertexFactory &vFactory , int file_type , const std::vector< std::string > &comments );
+		~StreamingPolygonWriter( void );
+
+		// Appends the polygons, sets the element counts, and closes the file
+		void writePolygons( InputDataStream< std::vector< Index > > &polygonStream , size_t polygonNum );
+	protected:
+		static const size_t _BlockSize = 1<<20;
+		PlyFile *_ply;
+		const VertexFactory &_vFactory;
+		Pointer( char ) _buffer;
+		std::vector< char > _data;
+		size_t _elementSize;
+
+		void base_write( const typename VertexFactory::VertexType &v );
+		void _flush( void );
+	};
+
 	// PLY read mesh functionality
 	template< typename VertexFactory , typename Index >
 	void ReadPolygons( std::string fileName , const VertexFactory &vFactory , std::vector< typename VertexFactory::VertexType > &vertices , std::vector< std::vector< Index > >& polygons , int &file_type , std::vector< std::string > &comments , bool* readFlags=NULL );
@@ -320,6 +320,42 @@ namespace PLY
 		delete ply;
 	}
 
+	// Writes the faces of a binary file in blocks, as for the vertices
+	template< typename Index , typename OutputIndex , bool UseCharIndex >
+	void _WriteBinaryPolygons( PlyFile *ply , InputDataStream< std::vector< Index > > &polygonStream , size_t polygonNum )
+	{
+		static const size_t BlockSize = 1<<16;
+		std::vector< char > data;
+
+		ply->put_element_setup( "face" );
+		std::vector< std::vector< Index > > polygons( std::min< size_t >( polygonNum , BlockSize ) );
+		std::vector< size_t > offsets( polygons.size()+1 );
+		for( size_t start=0 ; start<polygonNum ; start+=BlockSize )
+		{
+			size_t count = std::min< size_t >( polygonNum-start , BlockSize );
+			for( size_t i=0 ; i<count ; i++ ) if( !polygonStream.read( polygons[i] ) ) ERROR_OUT( "Failed to read polygon " , start+i , " / " , polygonNum );
+
+			auto EncodeFace = [&]( size_t i , char *buffer )
+			{
+				OutputIndex vertices[16];
+				std::vector< OutputIndex > _vertices;
+				Face< OutputIndex , UseCharIndex > ply_face;
+				ply_face.nr_vertices = (unsigned int)polygons[i].size();
+				if( polygons[i].size()>16 ) _vertices.resize( polygons[i].size() ) , ply_face.vertices = &_vertices[0];
+				else ply_face.vertices = vertices;
+				for( size_t j=0 ; j<polygons[i].size() ; j++ ) ply_face.vertices[j] = (OutputIndex)polygons[i][j];
+				if( buffer ) return ply->encode_binary_element( (void *)&ply_face , buffer );
+				else         return ply->binary_element_size( (void *)&ply_face );
+			};
+
+			offsets[0] = 0;
+			for( size_t i=0 ; i<count ; i++ ) offsets[i+1] = offsets[i] + EncodeFace( i , NULL );
+			data.resize( offsets[count] );
+			ThreadPool::Parallel_for( 0 , count , [&]( unsigned int , size_t i ){ EncodeFace( i , &data[ offsets[i] ] ); } );
+			ply->put_binary_data( &data[0] , data.size() );
+		}
+	}
+
 	template< typename VertexFactory , typename Index , class Real , int Dim , typename OutputIndex , bool UseCharIndex >
 	void WritePolygons( std::string fileName , const VertexFactory &vFactory , size_t vertexNum , size_t polygonNum , InputDataStream< typename VertexFactory::VertexType > &vertexStream , InputDataStream< std::vector< Index > > &polygonStream , int file_type , const std::vector< std::string > &comments )
 	{
@@ -353,48 +389,168 @@ namespace PLY
 		for( int i=0 ; i<comments.size() ; i++ ) ply->put_comment( comments[i] );
 		ply->header_complete();
 
-		// write vertices
-		ply->put_element_setup( "vertex" );
-		if( vFactory.isStaticallyAllocated() )
+		if( file_type==PLY_ASCII )
 		{
-			for( size_t i=0; i<vertexNum ; i++ )
+			// write vertices
+			ply->put_element_setup( "vertex" );
+			if( vFactory.isStaticallyAllocated() )
 			{
-				typename VertexFactory::VertexType vertex = vFactory();
-				if( !vertexStream.read( vertex ) ) ERROR_OUT( "Failed to read vertex " , i , " / " , vertexNum );
-				ply->put_element( (void *)&vertex );
+				for( size_t i=0; i<vertexNum ; i++ )
+				{
+					typename VertexFactory::VertexType vertex = vFactory();
+					if( !vertexStream.read( vertex ) ) ERROR_OUT( "Failed to read vertex " , i , " / " , vertexNum );
+					ply->put_element( (void *)&vertex );
+				}
 			}
+			else
+			{
+				Pointer( char ) buffer = NewPointer< char >( vFactory.bufferSize() );
+				for( size_t i=0; i<vertexNum ; i++ )
+				{
+					typename VertexFactory::VertexType vertex = vFactory();
+					if( !vertexStream.read( vertex ) ) ERROR_OUT( "Failed to read vertex " , i , " / " , vertexNum );
+					vFactory.toBuffer( vertex , buffer );
+					ply->put_element( PointerAddress( buffer ) );
+				}
+				DeletePointer( buffer );
+			}
+
+			// write faces
+			std::vector< Index > polygon;
+			ply->put_element_setup( "face" );
+			for( size_t i=0 ; i<polygonNum ; i++ )
+			{
+				//
+				// create and fill a struct that the ply code can handle
+				//
+				Face< OutputIndex > ply_face;
+				if( !polygonStream.read( polygon ) ) ERROR_OUT( "Failed to read polygon " , i , " / " , polygonNum ); 
+				ply_face.nr_vertices = int( polygon.size() );
+				ply_face.vertices = new OutputIndex[ polygon.size() ];
+				for( int j=0 ; j<int(polygon.size()) ; j++ ) ply_face.vertices[j] = (OutputIndex)polygon[j];
+				ply->put_element( (void *)&ply_face );
+				delete[] ply_face.vertices;
+			}  // for, write faces
+
 		}
 		else
 		{
-			Pointer( char ) buffer = NewPointer< char >( vFactory.bufferSize() );
-			for( size_t i=0; i<vertexNum ; i++ )
+			// Binary files are written in blocks: the elements of a block are read from the stream,
+			// encoded in parallel into a single buffer, and the buffer is written out in one call.
+			static const size_t BlockSize = 1<<16;
+			std::vector< char > data;
+
+			// write vertices
+			ply->put_element_setup( "vertex" );
 			{
-				typename VertexFactory::VertexType vertex = vFactory();
-				if( !vertexStream.read( vertex ) ) ERROR_OUT( "Failed to read vertex " , i , " / " , vertexNum );
-				vFactory.toBuffer( vertex , buffer );
-				ply->put_element( PointerAddress( buffer ) );
+				std::vector< typename VertexFactory::VertexType > vertices( std::min< size_t >( vertexNum , BlockSize ) , vFactory() );
+				std::vector< Pointer( char ) > buffers( ThreadPool::NumThreads() );
+				if( !vFactory.isStaticallyAllocated() ) for( size_t t=0 ; t<buffers.size() ; t++ ) buffers[t] = NewPointer< char >( vFactory.bufferSize() );
+				auto ElementPointer = [&]( unsigned int thread , size_t i )
+				{
+					if( vFactory.isStaticallyAllocated() ) return (void *)&vertices[i];
+					vFactory.toBuffer( vertices[i] , buffers[thread] );
+					return (void *)PointerAddress( buffers[thread] );
+				};
+
+				size_t elementSize = 0;
+				for( size_t start=0 ; start<vertexNum ; start+=BlockSize )
+				{
+					size_t count = std::min< size_t >( vertexNum-start , BlockSize );
+					for( size_t i=0 ; i<count ; i++ ) if( !vertexStream.read( vertices[i] ) ) ERROR_OUT( "Failed to read vertex " , start+i , " / " , vertexNum );
+					// Vertices have no list properties so all have the same size
+					if( !elementSize ) elementSize = ply->binary_element_size( ElementPointer( 0 , 0 ) );
+					data.resize( count * elementSize );
+					ThreadPool::Parallel_for( 0 , count , [&]( unsigned int thread , size_t i ){ ply->encode_binary_element( ElementPointer( thread , i ) , &data[i*elementSize] ); } );
+					ply->put_binary_data( &data[0] , data.size() );
+				}
+				if( !vFactory.isStaticallyAllocated() ) for( size_t t=0 ; t<buffers.size() ; t++ ) DeletePointer( buffers[t] );
 			}
-			DeletePointer( buffer );
+
+			// write faces
+			_WriteBinaryPolygons< Index , OutputIndex , UseCharIndex >( ply , polygonStream , polygonNum );
 		}
 
-		// write faces
-		std::vector< Index > polygon;
-		ply->put_element_setup( "face" );
-		for( size_t i=0 ; i<polygonNum ; i++ )
+		delete ply;
+	}
+
+	template< typename VertexFactory , typename Index , typename OutputIndex , bool UseCharIndex >
+	StreamingPolygonWriter< VertexFactory , Index , OutputIndex , UseCharIndex >::StreamingPolygonWriter( std::string fileName , const VertexFactory &vFactory , int file_type , const std::vector< std::string > &comments ) : _vFactory( vFactory ) , _buffer( NullPointer( char ) ) , _elementSize(0)
+	{
+		if( file_type==PLY_ASCII ) ERROR_OUT( "Streaming is only supported for binary files" );
+		std::vector< std::string > elem_names = { std::string( "vertex" ) , std::string( "face" ) };
+		float version;
+		_ply = PlyFile::Write( fileName , elem_names , file_type , version );
+		if( !_ply ) ERROR_OUT( "Could not create ply file for writing: " , fileName );
+
+		//
+		// describe vertex and face properties
+		//
+		for( unsigned int i=0 ; i<vFactory.plyWriteNum() ; i++ )
 		{
-			//
-			// create and fill a struct that the ply code can handle
-			//
-			Face< OutputIndex > ply_face;
-			if( !polygonStream.read( polygon ) ) ERROR_OUT( "Failed to read polygon " , i , " / " , polygonNum ); 
-			ply_face.nr_vertices = int( polygon.size() );
-			ply_face.vertices = new OutputIndex[ polygon.size() ];
-			for( int j=0 ; j<int(polygon.size()) ; j++ ) ply_face.vertices[j] = (OutputIndex)polygon[j];
-			ply->put_element( (void *)&ply_face );
-			delete[] ply_face.vertices;
-		}  // for, write faces
+			PlyProperty prop = vFactory.isStaticallyAllocated() ? vFactory.plyStaticWriteProperty(i) : vFactory.plyWriteProperty(i);
+			_ply->describe_property( "vertex" , &prop );
+		}
+		_ply->describe_property( "face" , Face< OutputIndex , UseCharIndex >::Properties );
 
+		// Write in the comments
+		for( int i=0 ; i<comments.size() ; i++ ) _ply->put_comment( comments[i] );
 
-		delete ply;
+		// The counts are not known yet, so reserve space for them in the header
+		_ply->header_complete( true );
+
+		_ply->put_element_setup( "vertex" );
+		if( !vFactory.isStaticallyAllocated() ) _buffer = NewPointer< char >( vFactory.bufferSize() );
+		_data.reserve( _BlockSize );
+	}
+
+	template< typename VertexFactory , typename Index , typename OutputIndex , bool UseCharIndex >
+	StreamingPolygonWriter< VertexFactory , Index , OutputIndex , UseCharIndex >::~StreamingPolygonWriter( void )
+	{
+		DeletePointer( _buffer );
+		delete _ply;
+	}
+
+	template< typename VertexFactory , typename Index , typename OutputIndex , bool UseCharIndex >
+	void StreamingPolygonWriter< VertexFactory , Index , OutputIndex , UseCharIndex >::base_write( const typename VertexFactory::VertexType &v )
+	{
+		if( this->size()>(size_t)std::numeric_limits< OutputIndex >::max() ) ERROR_OUT( "more vertices than can be represented using " , Traits< OutputIndex >::name );
+
+		void *element;
+		if( _vFactory.isStaticallyAllocated() ) element = (void *)&v;
+		else
+		{
+			_vFactory.toBuffer( v , _buffer );
+			element = (void *)PointerAddress( _buffer );
+		}
+
+		// Vertices have no list properties so all have the same size
+		if( !_elementSize ) _elementSize = _ply->binary_element_size( element );
+		if( _data.size()+_elementSize>_BlockSize ) _flush();
+		size_t sz = _data.size();
+		_data.resize( sz + _elementSize );
+		_ply->encode_binary_element( element , &_data[sz] );
+	}
+
+	template< typename VertexFactory , typename Index , typename OutputIndex , bool UseCharIndex >
+	void StreamingPolygonWriter< VertexFactory , Index , OutputIndex , UseCharIndex >::_flush( void )
+	{
+		if( _data.size() ) _ply->put_binary_data( &_data[0] , _data.size() );
+		_data.resize( 0 );
+	}
+
+	template< typename VertexFactory , typename Index , typename OutputIndex , bool UseCharIndex >
+	void StreamingPolygonWriter< VertexFactory , Index , OutputIndex , UseCharIndex >::writePolygons( InputDataStream< std::vector< Index > > &polygonStream , size_t polygonNum )
+	{
+		if( !_ply ) ERROR_OUT( "Polygons have already been written" );
+		_flush();
+
+		polygonStream.reset();
+		_WriteBinaryPolygons< Index , OutputIndex , UseCharIndex >( _ply , polygonStream , polygonNum );
+
+		_ply->patch_element_count( "vertex" , this->size() );
+		_ply->patch_element_count( "face" , polygonNum );
+		delete _ply;
+		_ply = NULL;
 	}
 }
@@ -183,6 +183,7 @@ struct PlyElement
 	std::vector< PlyStoredProperty > props; /* list of properties in the file */
 	int other_offset;             /* offset to un-asked-for props, or -1 if none*/
 	int other_size;               /* size of other_props structure */
+	long count_offset = -1;       /* file offset of the count in the header, or -1 if it cannot be patched */
 	PlyProperty *find_property( const std::string &prop_name , int &index );
 };
 
@@ -239,9 +240,15 @@ struct PlyFile
 	void describe_other_elements( PlyOtherElems * );
 	PlyElement *find_element( const std::string & );
 	void element_count( const std::string & , size_t );
-	void header_complete( void );
+	void header_complete( bool patchableCounts=false );
+	// Overwrites the count of an element in a header written with patchable counts
+	void patch_element_count( const std::string & , size_t );
 	void put_element_setup( const std::string & );
 	void put_element ( void * );
+	// Binary files only: the size of the element in the file, its encoding into a buffer, and the writing of encoded elements
+	size_t binary_element_size( void * ) const;
+	size_t encode_binary_element( void * , char * ) const;
+	void put_binary_data( const char * , size_t );
 	void put_comment ( const std::string & );
 	void put_obj_info( const std::string & );
 	void put_other_elements( void );
@@ -134,6 +134,7 @@ void write_scalar_type( FILE * , int );
 
 /* write an item to a file */
 void write_binary_item( FILE * , int , int , unsigned int , long long , unsigned long long , double , int );
+size_t encode_binary_item( char * , int , int , unsigned int , long long , unsigned long long , double , int );
 void write_ascii_item ( FILE * ,       int , unsigned int , long long , unsigned long long , double , int );
 
 /* store a value into where a pointer and a type specify */
@@ -326,9 +327,15 @@ void PlyFile::element_count( const std::string &elem_name , size_t nelems )
 /******************************************************************************
 Signal that we've described everything a PLY file's header and that the
 header should be written to the file.
+
+Entry:
+patchableCounts - reserve fixed-width space for the element counts so that
+                  they can be set after the elements have been written
 ******************************************************************************/
 
-void PlyFile::header_complete( void )
+static const int PLY_PATCHABLE_COUNT_WIDTH = 20;
+
+void PlyFile::header_complete( bool patchableCounts )
 {
 	fprintf( fp , "ply\n" );
 	switch( file_type )
@@ -348,7 +355,13 @@ void PlyFile::header_complete( void )
 	/* write out information about each element */
 	for( int i=0 ; i<elems.size() ; i++ )
 	{
-		fprintf( fp , "element %s %llu\n" , elems[i].name.c_str() , (unsigned long long)elems[i].num );
+		if( patchableCounts )
+		{
+			fprintf( fp , "element %s " , elems[i].name.c_str() );
+			elems[i].count_offset = ftell( fp );
+			fprintf( fp , "%-*llu\n" , PLY_PATCHABLE_COUNT_WIDTH , (unsigned long long)elems[i].num );
+		}
+		else fprintf( fp , "element %s %llu\n" , elems[i].name.c_str() , (unsigned long long)elems[i].num );
 
 		for( int j=0 ; j<elems[i].props.size() ; j++ )
 		{
@@ -373,6 +386,28 @@ void PlyFile::header_complete( void )
 }
 
 
+/******************************************************************************
+Overwrite the count of an element in a header that was written with
+patchable counts. The file position is restored to the end of the file.
+
+Entry:
+elem_name - name of element whose count is being set
+nelems    - number of elements of this type that were written
+******************************************************************************/
+
+void PlyFile::patch_element_count( const std::string &elem_name , size_t nelems )
+{
+	PlyElement *elem = find_element( elem_name );
+	if( elem==NULL ) ERROR_OUT( "Can't find element '" , elem_name , "'" );
+	if( elem->count_offset<0 ) ERROR_OUT( "Count of element '" , elem_name , "' is not patchable" );
+
+	elem->num = nelems;
+	if( fseek( fp , elem->count_offset , SEEK_SET ) ) ERROR_OUT( "Failed to seek to count of element '" , elem_name , "'" );
+	fprintf( fp , "%-*llu" , PLY_PATCHABLE_COUNT_WIDTH , (unsigned long long)nelems );
+	if( fseek( fp , 0 , SEEK_END ) ) ERROR_OUT( "Failed to seek to end of file" );
+}
+
+
 /******************************************************************************
 Specify which elements are going to be written.  This should be called
 before a call to the routine ply_put_element().
@@ -485,6 +520,98 @@ void PlyFile::put_element( void *elem_ptr )
 }
 
 
+/******************************************************************************
+Get the number of bytes an element occupies in a binary file.  This routine
+assumes that we're writing the type of element specified in the last call to
+the routine ply_put_element_setup().
+
+Entry:
+elem_ptr - pointer to the element
+******************************************************************************/
+
+size_t PlyFile::binary_element_size( void *elem_ptr ) const
+{
+	const PlyElement *elem = which_elem;
+	char **other_ptr = (char **) (((char *) elem_ptr) + elem->other_offset);
+	size_t size = 0;
+	for( int j=0 ; j<elem->props.size() ; j++ )
+	{
+		if( elem->props[j].prop.is_list )
+		{
+			char *elem_data = elem->props[j].store==OTHER_PROP ? *other_ptr : (char *)elem_ptr;
+			int int_val ; unsigned int uint_val ; long long longlong_val ; unsigned long long ulonglong_val ; double double_val;
+			get_stored_item( (void *)( elem_data + elem->props[j].prop.count_offset ) , elem->props[j].prop.count_internal , int_val , uint_val , longlong_val , ulonglong_val , double_val );
+			size += ply_type_size[ elem->props[j].prop.count_external ] + (size_t)uint_val * ply_type_size[ elem->props[j].prop.external_type ];
+		}
+		else size += ply_type_size[ elem->props[j].prop.external_type ];
+	}
+	return size;
+}
+
+
+/******************************************************************************
+Encode an element into a buffer, in the binary format of the file.  This
+routine assumes that we're writing the type of element specified in the last
+call to the routine ply_put_element_setup().  The routine does not modify the
+file, so elements can be encoded concurrently.
+
+Entry:
+elem_ptr - pointer to the element
+buffer   - the buffer the encoded element is written to
+
+Exit:
+returns the number of bytes written
+******************************************************************************/
+
+size_t PlyFile::encode_binary_element( void *elem_ptr , char *buffer ) const
+{
+	if( file_type==PLY_ASCII ) ERROR_OUT( "Cannot encode elements of an ascii file" );
+	const PlyElement *elem = which_elem;
+	char **other_ptr = (char **) (((char *) elem_ptr) + elem->other_offset);
+	char *start = buffer;
+	int int_val ; unsigned int uint_val ; long long longlong_val ; unsigned long long ulonglong_val ; double double_val;
+
+	for( int j=0 ; j<elem->props.size() ; j++ )
+	{
+		char *elem_data = elem->props[j].store==OTHER_PROP ? *other_ptr : (char *)elem_ptr;
+		if( elem->props[j].prop.is_list )
+		{
+			get_stored_item( (void *)( elem_data + elem->props[j].prop.count_offset ) , elem->props[j].prop.count_internal , int_val , uint_val , longlong_val , ulonglong_val , double_val );
+			buffer += encode_binary_item( buffer , file_type , int_val , uint_val , longlong_val , ulonglong_val , double_val , elem->props[j].prop.count_external );
+			int list_count = uint_val;
+			char *item = ( (char **)( elem_data + elem->props[j].prop.offset ) )[0];
+			int item_size = ply_type_size[ elem->props[j].prop.internal_type ];
+			for( int k=0 ; k<list_count ; k++ )
+			{
+				get_stored_item( (void *)item , elem->props[j].prop.internal_type , int_val , uint_val , longlong_val , ulonglong_val , double_val );
+				buffer += encode_binary_item( buffer , file_type , int_val , uint_val , longlong_val , ulonglong_val , double_val , elem->props[j].prop.external_type );
+				item += item_size;
+			}
+		}
+		else
+		{
+			get_stored_item( (void *)( elem_data + elem->props[j].prop.offset ) , elem->props[j].prop.internal_type , int_val , uint_val , longlong_val , ulonglong_val , double_val );
+			buffer += encode_binary_item( buffer , file_type , int_val , uint_val , longlong_val , ulonglong_val , double_val , elem->props[j].prop.external_type );
+		}
+	}
+	return (size_t)( buffer - start );
+}
+
+
+/******************************************************************************
+Write a block of encoded elements to the file.
+
+Entry:
+buffer - the encoded elements
+size   - the number of bytes to write
+******************************************************************************/
+
+void PlyFile::put_binary_data( const char *buffer , size_t size )
+{
+	if( size && fwrite( buffer , 1 , size , fp )!=size ) ERROR_OUT( "Failed to write binary data" );
+}
+
+
 /******************************************************************************
 Specify a comment that will be written in the header.
 
@@ -1444,6 +1571,28 @@ type       - data type to write out
 ******************************************************************************/
 
 void write_binary_item( FILE *fp , int file_type , int int_val , unsigned int uint_val , long long longlong_val , unsigned long long ulonglong_val , double double_val , int type )
+{
+	char buffer[8];
+	size_t size = encode_binary_item( buffer , file_type , int_val , uint_val , longlong_val , ulonglong_val , double_val , type );
+	if( fwrite( buffer , size , 1 , fp )!=1 ) ERROR_OUT( "Failed to write binary item" );
+}
+
+
+/******************************************************************************
+Write out an item to a buffer as raw binary bytes.
+
+Entry:
+buffer     - buffer to write to
+int_val    - integer version of item
+uint_val   - unsigned integer version of item
+double_val - double-precision float version of item
+type       - data type to write out
+
+Exit:
+returns the number of bytes written
+******************************************************************************/
+
+size_t encode_binary_item( char *buffer , int file_type , int int_val , unsigned int uint_val , long long longlong_val , unsigned long long ulonglong_val , double double_val , int type )
 {
 	unsigned char uchar_val;
 	char char_val;
@@ -1503,7 +1652,8 @@ void write_binary_item( FILE *fp , int file_type , int int_val , unsigned int ui
 
 
 	if( (file_type!=native_binary_type) && (ply_type_size[type]>1) ) swap_bytes( (char *)value , ply_type_size[type] );
-	if( fwrite( value , ply_type_size[type] , 1 , fp )!=1 ) ERROR_OUT( "Failed to write binary item" );
+	memcpy( buffer , value , ply_type_size[type] );
+	return ply_type_size[type];
 }
 
 
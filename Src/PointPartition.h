@@ -39,6 +39,7 @@ DAMAGE.
 
 #define ADAPTIVE_PADDING			// Only pushes padding points deep enough so that they are "close" to the slab in terms of units at that depth
 #define BUFFER_IO (1<<14)			// Buffer the points before reading/writing
+#define PARTITION_CHUNK (1<<18)		// The number of points read by a thread at a time when partitioning
 //#define AXIS_ONLY_ALIGNMENT			// Only align to the three coordinate axes (should be disabled)
 
 
@@ -77,10 +78,32 @@ namespace PointPartition
 		Extent operator + ( const Extent &e ) const;
 	};
 
+	// Statistics of the input gathered in a single pass, optionally cached in a sidecar file
+	template< typename Real >
+	struct Statistics
+	{
+		size_t count , zeroNormalCount;
+		double normalLengthSum;
+		Extent< Real > extent;
+
+		Statistics( void );
+		void add( Point< Real , 3 > p , Point< Real , 3 > n );
+		Statistics operator + ( const Statistics &s ) const;
+
+		// The cache is keyed by the input's path, size, and modification time
+		bool read( std::string cacheFile , std::string in );
+		void write( std::string cacheFile , std::string in ) const;
+
+		static std::string CacheFile( std::string dir , std::string in );
+	};
+
 	struct Partition
 	{
 		Partition( void );
 		Partition( unsigned int dCount , const std::vector< size_t > &slabSizes );
+		Partition( BinaryStream &stream );
+
+		void write( BinaryStream &stream ) const;
 
 #ifdef ADAPTIVE_PADDING
 		void optimize( bool useMax );
@@ -131,10 +154,12 @@ namespace PointPartition
 	struct BufferedBinaryOutputDataStream : public OutputDataStream< typename OutputFactory::VertexType >
 	{
 		typedef typename OutputFactory::VertexType Data;
-		BufferedBinaryOutputDataStream( const char *fileName , const OutputFactory &factory , size_t bufferSize );
+		BufferedBinaryOutputDataStream( const char *fileName , const OutputFactory &factory , size_t bufferSize , bool directIO=false );
 		~BufferedBinaryOutputDataStream( void );
 		void reset( void );
 		void base_write( const Data &d );
+		// Writes elements that have already been serialized by the factory
+		void write_serialized( const char *elements , size_t count );
 	protected:
 		size_t _bufferSize , _current , _elementSize;
 		Pointer( char ) _buffer;
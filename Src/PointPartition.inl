@@ -159,6 +159,87 @@ std::ostream &operator << ( std::ostream &os , const Extent< Real > &e )
 }
 
 
+////////////////
+// Statistics //
+////////////////
+template< typename Real >
+Statistics< Real >::Statistics( void ) : count(0) , zeroNormalCount(0) , normalLengthSum(0) {}
+
+template< typename Real >
+void Statistics< Real >::add( Point< Real , 3 > p , Point< Real , 3 > n )
+{
+	Real l = (Real)Length( n );
+	count++;
+	if( l==0 ) zeroNormalCount++;
+	normalLengthSum += l;
+	extent.add( p );
+}
+
+template< typename Real >
+Statistics< Real > Statistics< Real >::operator + ( const Statistics< Real > &s ) const
+{
+	Statistics _s;
+	_s.count = count + s.count;
+	_s.zeroNormalCount = zeroNormalCount + s.zeroNormalCount;
+	_s.normalLengthSum = normalLengthSum + s.normalLengthSum;
+	_s.extent = extent + s.extent;
+	return _s;
+}
+
+template< typename Real >
+std::string Statistics< Real >::CacheFile( std::string dir , std::string in )
+{
+	std::stringstream sStream;
+	sStream << std::filesystem::path( in ).filename().string() << "." << std::hex << std::hash< std::string >{}( std::filesystem::absolute( in ).string() ) << ".stats";
+	if( dir.back()==FileSeparator ) return dir + sStream.str();
+	else return dir + std::string(1,FileSeparator) + sStream.str();
+}
+
+template< typename Real >
+bool Statistics< Real >::read( std::string cacheFile , std::string in )
+{
+	FILE *fp = fopen( cacheFile.c_str() , "rb" );
+	if( !fp ) return false;
+	FileStream fs( fp );
+	std::string path;
+	size_t size;
+	long long time;
+	bool success = fs.read( path ) && fs.read( size ) && fs.read( time );
+	try
+	{
+		success = success && path==std::filesystem::absolute( in ).string() && size==std::filesystem::file_size( in ) && time==(long long)std::filesystem::last_write_time( in ).time_since_epoch().count();
+	}
+	catch( ... ){ success = false; }
+	success = success && fs.read( count ) && fs.read( zeroNormalCount ) && fs.read( normalLengthSum ) && fs.read( extent );
+	fclose( fp );
+	if( !success ) *this = Statistics();
+	return success;
+}
+
+template< typename Real >
+void Statistics< Real >::write( std::string cacheFile , std::string in ) const
+{
+	// Write to a temporary file and rename so that concurrent runs never see a partial cache
+	std::string tempFile = cacheFile + std::string( ".tmp" );
+	FILE *fp = fopen( tempFile.c_str() , "wb" );
+	if( !fp )
+	{
+		WARN( "Failed to open statistics cache for writing: " , cacheFile );
+		return;
+	}
+	FileStream fs( fp );
+	fs.write( std::filesystem::absolute( in ).string() );
+	fs.write( (size_t)std::filesystem::file_size( in ) );
+	fs.write( (long long)std::filesystem::last_write_time( in ).time_since_epoch().count() );
+	fs.write( count );
+	fs.write( zeroNormalCount );
+	fs.write( normalLengthSum );
+	fs.write( extent );
+	fclose( fp );
+	try{ std::filesystem::rename( tempFile , cacheFile ); }
+	catch( ... ){ WARN( "Failed to rename: " , tempFile , " -> " , cacheFile ); }
+}
+
 //////////////////
 // PointSetInfo //
 //////////////////
@@ -353,6 +434,18 @@ Partition::Partition( unsigned int dCount , const std::vector< size_t > &slabSiz
 	for( unsigned int i=1 ; i<dCount ; i++ ) _starts[i-1] = ( sCount * i ) / dCount;
 }
 
+Partition::Partition( BinaryStream &stream )
+{
+	if( !stream.read( _starts ) ) ERROR_OUT( "Failed to read starts" );
+	if( !stream.read( _slabSizes ) ) ERROR_OUT( "Failed to read slab sizes" );
+}
+
+void Partition::write( BinaryStream &stream ) const
+{
+	stream.write( _starts );
+	stream.write( _slabSizes );
+}
+
 #ifdef ADAPTIVE_PADDING
 void Partition::optimize( bool useMax )
 #else // !ADAPTIVE_PADDING
@@ -615,7 +708,7 @@ bool BufferedBinaryInputDataStream< InputFactory >::base_read( Data &d )
 ////////////////////////////////////
 
 template< typename OutputFactory >
-BufferedBinaryOutputDataStream< OutputFactory >::BufferedBinaryOutputDataStream( const char *fileName , const OutputFactory &factory , size_t bufferSize ) : _factory(factory) , _bufferSize(bufferSize) , _current(0)
+BufferedBinaryOutputDataStream< OutputFactory >::BufferedBinaryOutputDataStream( const char *fileName , const OutputFactory &factory , size_t bufferSize , bool directIO ) : _factory(factory) , _bufferSize(bufferSize) , _current(0)
 {
 	if( !_bufferSize )
 	{
@@ -626,6 +719,8 @@ BufferedBinaryOutputDataStream< OutputFactory >::BufferedBinaryOutputDataStream(
 	_buffer = AllocPointer< char >( _elementSize*_bufferSize );
 	_fp = fopen( fileName , "wb" );
 	if( !_fp ) ERROR_OUT( "Could not open file for writing: " , fileName );
+	// Since we already buffer, bypass the stdio buffer so that blocks go straight to the file
+	if( directIO ) setvbuf( _fp , NULL , _IONBF , 0 );
 	std::vector< PlyProperty > properties( factory.plyWriteNum() );
 	for( unsigned int i=0 ; i<factory.plyWriteNum() ; i++ ) properties[i] = factory.plyWriteProperty(i);
 	_inset = WritePLYProperties( _fp , properties );
@@ -657,3 +752,21 @@ void BufferedBinaryOutputDataStream< OutputFactory >::base_write( const Data &d
 	_factory.toBuffer( d , _buffer + _elementSize*_current );
 	_current++;
 }
+
+template< typename OutputFactory >
+void BufferedBinaryOutputDataStream< OutputFactory >::write_serialized( const char *elements , size_t count )
+{
+	if( _current+count>_bufferSize )
+	{
+		if( _current ) fwrite( _buffer , _elementSize , _current , _fp );
+		_current = 0;
+		// Large blocks are written directly
+		if( count>=_bufferSize )
+		{
+			fwrite( elements , _elementSize , count , _fp );
+			return;
+		}
+	}
+	memcpy( PointerAddress( _buffer + _elementSize*_current ) , elements , _elementSize*count );
+	_current += count;
+}
@@ -47,6 +47,9 @@ namespace PointPartitionClientServer
 		unsigned int slabs , filesPerDir , bufferSize , clientCount;
 		Real scale;
 		bool verbose;
+		unsigned int memoryMB;		// If positive, the buffers used for partitioning are sized to fit in this budget
+		bool directIO;				// Bypass the stdio buffering when writing the slabs
+		bool computeStatistics;		// Scan the input for its statistics (unset if they were read from the cache)
 
 		ClientPartitionInfo( void );
 		ClientPartitionInfo( BinaryStream &stream );
@@ -60,7 +63,8 @@ namespace PointPartitionClientServer
 	(
 		std::vector< Socket > &clientSockets ,
 		ClientPartitionInfo< Real > clientPartitionInfo ,
-		bool loadBalance
+		bool loadBalance ,
+		bool cacheStatistics=false
 	);
 
 	template< typename Real , unsigned int Dim >
@@ -105,69 +105,117 @@ void _ProcessPLY( std::string in , std::pair< size_t , size_t > range , const Fa
 }
 
 template< typename Real , unsigned int Dim , typename Factory >
-void _MergeSlabs( std::string inDir , std::string outDir , std::string header , unsigned int clientCount , std::pair< unsigned int , unsigned int > slabRange , unsigned int slabs , unsigned int filesPerDir , const Factory &factory , size_t bufferSize )
+void _MergeSlabs( std::string inDir , std::string outDir , std::string header , unsigned int clientCount , std::pair< unsigned int , unsigned int > slabRange , unsigned int slabs , unsigned int filesPerDir , const Factory &factory , size_t bufferSize , bool directIO )
 {
 	using Vertex = typename Factory::VertexType;
 
-	Vertex v = factory();
-
-	for( unsigned int s=slabRange.first ; s<slabRange.second ; s++ )
+	// The slabs are independent so they can be merged in parallel
+	ThreadPool::Parallel_for( slabRange.first , slabRange.second , [&]( unsigned int , size_t s )
 	{
-		std::string outFileName = PointPartition::FileName( outDir , header , s , slabs , filesPerDir );
-		PointPartition::BufferedBinaryOutputDataStream< Factory > outStream( outFileName.c_str() , factory , bufferSize );
+		Vertex v = factory();
+		std::string outFileName = PointPartition::FileName( outDir , header , (unsigned int)s , slabs , filesPerDir );
+		PointPartition::BufferedBinaryOutputDataStream< Factory > outStream( outFileName.c_str() , factory , bufferSize , directIO );
 		for( unsigned int c=0 ; c<clientCount ; c++ )
 		{
-			std::string inFileName = PointPartition::FileName( inDir , header , c , s , slabs , filesPerDir );
+			std::string inFileName = PointPartition::FileName( inDir , header , c , (unsigned int)s , slabs , filesPerDir );
 			PointPartition::BufferedBinaryInputDataStream< Factory > inStream( inFileName.c_str() , factory , bufferSize );
 			while( inStream.read( v ) ) outStream.write( v );
 		}
-	}
+	} , ThreadPool::DYNAMIC , 1 );
+}
+
+// Splits the range into chunks and processes them in parallel
+template< typename ChunkFunctor /* = std::function< void ( unsigned int thread , size_t chunk , std::pair< size_t , size_t > range ) > */ >
+void _ProcessChunks( std::pair< size_t , size_t > range , size_t chunkSize , ChunkFunctor cf )
+{
+	if( range.first>=range.second ) return;
+	size_t chunks = ( range.second - range.first + chunkSize - 1 ) / chunkSize;
+	size_t threads = std::min< size_t >( ThreadPool::NumThreads() , chunks );
+
+	// [NOTE] Chunks are handed out in order so that a thread waiting on an earlier chunk is always waiting on a thread that is running
+	std::atomic< size_t > nextChunk(0);
+	ThreadPool::Parallel_for( 0 , threads , [&]( unsigned int , size_t t )
+	{
+		size_t c;
+		while( ( c=nextChunk++ )<chunks ) cf( (unsigned int)t , c , std::pair< size_t , size_t >( range.first + c*chunkSize , std::min< size_t >( range.first + (c+1)*chunkSize , range.second ) ) );
+	} , ThreadPool::DYNAMIC , 1 );
 }
 
 template< typename Real , unsigned int Dim , typename Factory >
-std::vector< size_t > _PartitionIntoSlabs( std::string in , std::string dir , std::string header , unsigned int clientIndex , std::pair< size_t , size_t > range , unsigned int slabs , unsigned int filesPerDir , XForm< Real , Dim+1 > xForm , const Factory &factory , size_t bufferSize )
+std::vector< size_t > _PartitionIntoSlabs( std::string in , std::string dir , std::string header , unsigned int clientIndex , std::pair< size_t , size_t > range , unsigned int slabs , unsigned int filesPerDir , XForm< Real , Dim+1 > xForm , const Factory &factory , size_t bufferSize , size_t chunkSize , bool directIO )
 {
 	using Vertex = typename Factory::VertexType;
 	using _XForm = typename Factory::Transform;
 
 	_XForm _xForm(xForm);
 	std::vector< size_t > slabSizes( slabs , 0 );
+	size_t elementSize = factory.bufferSize();
 
-	using OutputPointStream = OutputDataStream< Vertex >;
-
-	std::vector< OutputPointStream * > outStreams( slabs );
+	std::vector< PointPartition::BufferedBinaryOutputDataStream< Factory > * > outStreams( slabs );
 	for( unsigned int s=0 ; s<slabs ; s++ )
 	{
 		std::string fileName = PointPartition::FileName( dir , header , clientIndex , s , slabs , filesPerDir );
-		outStreams[s] = new PointPartition::BufferedBinaryOutputDataStream< Factory >( fileName.c_str() , factory , bufferSize );
+		outStreams[s] = new PointPartition::BufferedBinaryOutputDataStream< Factory >( fileName.c_str() , factory , bufferSize , directIO );
 	}
 
-	size_t outOfRangeCount = 0;
-	auto vertexFunctor = [&]( Vertex v )
+	// Each thread routes the points of a chunk into its own per-slab staging buffers.
+	// The staged points are appended to the slab files in chunk order, so the files do not depend on the number of threads.
+	std::vector< std::vector< std::vector< char > > > staging( std::min< size_t >( ThreadPool::NumThreads() , ( range.second - range.first + chunkSize - 1 ) / chunkSize ) , std::vector< std::vector< char > >( slabs ) );
+	std::atomic< size_t > outOfRangeCount(0);
+	size_t nextChunkToWrite = 0;
+	std::mutex writeMutex;
+	std::condition_variable writeCondition;
+
+	_ProcessChunks( range , chunkSize , [&]( unsigned int t , size_t c , std::pair< size_t , size_t > _range )
 	{
-		_xForm.inPlace( v );
-		Point< Real , Dim > p = v.template get<0>();
-		int slab = (int)floor( p[Dim-1] * slabs );
-		if( slab>=0 && slab<(int)slabs )
+		std::vector< std::vector< char > > &_staging = staging[t];
+		size_t _outOfRangeCount = 0;
+		auto vertexFunctor = [&]( Vertex v )
 		{
-			outStreams[slab]->write( v );
-			slabSizes[slab]++;
+			_xForm.inPlace( v );
+			Point< Real , Dim > p = v.template get<0>();
+			int slab = (int)floor( p[Dim-1] * slabs );
+			if( slab>=0 && slab<(int)slabs )
+			{
+				std::vector< char > &buffer = _staging[slab];
+				buffer.resize( buffer.size() + elementSize );
+				factory.toBuffer( v , &buffer[ buffer.size()-elementSize ] );
+			}
+			else _outOfRangeCount++;
+		};
+		_ProcessPLY( in , _range , factory , vertexFunctor );
+		outOfRangeCount += _outOfRangeCount;
+
+		std::unique_lock< std::mutex > lock( writeMutex );
+		writeCondition.wait( lock , [&]( void ){ return nextChunkToWrite==c; } );
+		for( unsigned int s=0 ; s<slabs ; s++ ) if( _staging[s].size() )
+		{
+			size_t count = _staging[s].size() / elementSize;
+			outStreams[s]->write_serialized( &_staging[s][0] , count );
+			slabSizes[s] += count;
+			_staging[s].clear();
 		}
-		else outOfRangeCount++;
-	};
-	_ProcessPLY( in , range , factory , vertexFunctor );
+		nextChunkToWrite++;
+		writeCondition.notify_all();
+	} );
+
 	for( unsigned int i=0 ; i<slabs ; i++ ) delete outStreams[i];
-	if( outOfRangeCount ) WARN( "Out of range count: " , outOfRangeCount );
+	if( outOfRangeCount ) WARN( "Out of range count: " , (size_t)outOfRangeCount );
 	return slabSizes;
 }
 
 template< typename Real , unsigned int Dim , typename Factory >
-PointPartition::Extent< Real > _GetExtent( std::string in , std::pair< size_t , size_t > range , const Factory &factory )
+PointPartition::Statistics< Real > _GetStatistics( std::string in , std::pair< size_t , size_t > range , const Factory &factory , size_t chunkSize )
 {
 	using Vertex = typename Factory::VertexType;
-	PointPartition::Extent< Real > extent;
-	_ProcessPLY( in , range , factory , [&]( const Vertex &vertex ){ extent.add( vertex.template get<0>() ); } );
-	return extent;
+	std::vector< PointPartition::Statistics< Real > > statistics( ThreadPool::NumThreads() );
+	_ProcessChunks( range , chunkSize , [&]( unsigned int t , size_t , std::pair< size_t , size_t > _range )
+	{
+		_ProcessPLY( in , _range , factory , [&]( const Vertex &vertex ){ statistics[t].add( vertex.template get<0>() , vertex.template get<1>() ); } );
+	} );
+	PointPartition::Statistics< Real > _statistics;
+	for( unsigned int t=0 ; t<statistics.size() ; t++ ) _statistics = _statistics + statistics[t];
+	return _statistics;
 }
 
 template< typename Real , unsigned int Dim >
@@ -199,11 +247,19 @@ std::pair< PointPartition::PointSetInfo< Real , Dim > , PointPartition::Partitio
 (
 	std::vector< Socket > &clientSockets ,
 	ClientPartitionInfo< Real > clientPartitionInfo ,
-	bool loadBalance
+	bool loadBalance ,
+	bool cacheStatistics
 )
 {
 	Timer timer;
 	clientPartitionInfo.clientCount = ( unsigned int )clientSockets.size();
+
+	// If the statistics of the input have been cached, the clients do not need to scan it
+	PointPartition::Statistics< Real > statistics;
+	std::string statisticsFile = PointPartition::Statistics< Real >::CacheFile( clientPartitionInfo.tempDir , clientPartitionInfo.in );
+	clientPartitionInfo.computeStatistics = !cacheStatistics || !statistics.read( statisticsFile , clientPartitionInfo.in );
+	if( clientPartitionInfo.verbose && !clientPartitionInfo.computeStatistics ) std::cout << "Read statistics: " << statisticsFile << std::endl;
+
 	for( unsigned int c=0 ; c<clientSockets.size() ; c++ )
 	{
 		SocketStream clientSocketStream( clientSockets[c] );
@@ -237,16 +293,25 @@ std::pair< PointPartition::PointSetInfo< Real , Dim > , PointPartition::Partitio
 	/////////////
 	// Phase 2 //
 	/////////////
-	// Merge the clients' extents and get the direction of maximal extent
-	PointPartition::Extent< Real > e;
-	unsigned int idx;
+	// Merge the clients' statistics and get the direction of maximal extent
+	if( clientPartitionInfo.computeStatistics )
 	{
 		for( unsigned int c=0 ; c<clientSockets.size() ; c++ )
 		{
-			PointPartition::Extent< Real > _e;
-			SocketStream( clientSockets[c] ).read( _e );
-			e = e + _e;
+			PointPartition::Statistics< Real > _statistics;
+			SocketStream( clientSockets[c] ).read( _statistics );
+			statistics = statistics + _statistics;
 		}
+		if( cacheStatistics ) statistics.write( statisticsFile , clientPartitionInfo.in );
+	}
+	if( clientPartitionInfo.verbose )
+	{
+		std::cout << "Zero normals: " << statistics.zeroNormalCount << " / " << statistics.count << std::endl;
+		if( statistics.count ) std::cout << "Average normal length: " << statistics.normalLengthSum / statistics.count << std::endl;
+	}
+	const PointPartition::Extent< Real > &e = statistics.extent;
+	unsigned int idx;
+	{
 		idx = 0;
 		for( unsigned int d=1 ; d<PointPartition::Extent< Real >::DirectionN ; d++ ) if( e.extents[d].second - e.extents[d].first > e.extents[idx].second - e.extents[idx].first ) idx = d;
 	}
@@ -326,7 +391,17 @@ void _RunClients
 
 	for( unsigned int c=0 ; c<serverSockets.size() ; c++ ) SocketStream( serverSockets[c] ).read( clientIndices[c] );
 
-	int maxFiles = 2*clientPartitionInfo.slabs;
+	size_t bufferSize = clientPartitionInfo.bufferSize , chunkSize = PARTITION_CHUNK;
+	if( clientPartitionInfo.memoryMB )
+	{
+		// Split the budget between the per-slab output buffers and the per-thread staging buffers
+		size_t budget = ( (size_t)clientPartitionInfo.memoryMB<<20 ) / 2 , elementSize = factory.bufferSize();
+		bufferSize = std::max< size_t >( 1 , std::min< size_t >( bufferSize , budget / ( elementSize * clientPartitionInfo.slabs ) ) );
+		chunkSize = std::max< size_t >( 1 , std::min< size_t >( chunkSize , budget / ( elementSize * ThreadPool::NumThreads() ) ) );
+		if( clientPartitionInfo.verbose ) std::cout << "Buffer / chunk size: " << bufferSize << " / " << chunkSize << std::endl;
+	}
+
+	int maxFiles = 2*clientPartitionInfo.slabs + 2*(int)ThreadPool::NumThreads();
 #ifdef _WIN32
 	if( _setmaxstdio( maxFiles )!=maxFiles ) ERROR_OUT( "Could not set max file handles: " , maxFiles );
 #else // !_WIN32
@@ -347,10 +422,13 @@ void _RunClients
 		// Get the client's range
 		SocketStream( serverSockets[i] ).read( ranges[i] );
 		if( clientPartitionInfo.verbose ) std::cout << "Got range: " << MemoryInfo::PeakMemoryUsageMB() << " (MB)" << std::endl;
-		// Get the extent and send to the client
-		PointPartition::Extent< Real > e = _GetExtent< Real , Dim >( clientPartitionInfo.in , ranges[i] , factory );
-		SocketStream( serverSockets[i] ).write( e );
-		if( clientPartitionInfo.verbose ) std::cout << "Sent extent: " << MemoryInfo::PeakMemoryUsageMB() << " (MB)" << std::endl;
+		// Get the statistics (including the extent) and send to the server
+		if( clientPartitionInfo.computeStatistics )
+		{
+			PointPartition::Statistics< Real > statistics = _GetStatistics< Real , Dim >( clientPartitionInfo.in , ranges[i] , factory , chunkSize );
+			SocketStream( serverSockets[i] ).write( statistics );
+			if( clientPartitionInfo.verbose ) std::cout << "Sent statistics: " << MemoryInfo::PeakMemoryUsageMB() << " (MB)" << std::endl;
+		}
 	}
 
 	/////////////
@@ -363,7 +441,7 @@ void _RunClients
 		if( clientPartitionInfo.verbose ) std::cout << "Got transform: " << MemoryInfo::PeakMemoryUsageMB() << " (MB)" << std::endl;
 
 		PointPartition::CreatePointSlabDirs( PointPartition::FileDir( clientPartitionInfo.tempDir , clientPartitionInfo.outHeader , clientIndices[i] ) , clientPartitionInfo.slabs , clientPartitionInfo.filesPerDir );
-		std::vector< size_t > slabSizes = _PartitionIntoSlabs< Real , Dim >( clientPartitionInfo.in , clientPartitionInfo.tempDir , clientPartitionInfo.outHeader , clientIndices[i] , ranges[i] , clientPartitionInfo.slabs , clientPartitionInfo.filesPerDir , xForm , factory , clientPartitionInfo.bufferSize );
+		std::vector< size_t > slabSizes = _PartitionIntoSlabs< Real , Dim >( clientPartitionInfo.in , clientPartitionInfo.tempDir , clientPartitionInfo.outHeader , clientIndices[i] , ranges[i] , clientPartitionInfo.slabs , clientPartitionInfo.filesPerDir , xForm , factory , bufferSize , chunkSize , clientPartitionInfo.directIO );
 		SocketStream( serverSockets[i] ).write( slabSizes );
 		if( clientPartitionInfo.verbose ) std::cout << "Wrote slab sizes: " << MemoryInfo::PeakMemoryUsageMB() << " (MB)" << std::endl;
 	}
@@ -376,7 +454,7 @@ void _RunClients
 		std::pair< unsigned int , unsigned int > slabRange;
 		SocketStream( serverSockets[i] ).read( slabRange );
 		if( clientPartitionInfo.verbose ) std::cout << "Slab range: [ " << slabRange.first << " , " << slabRange.second << " )" << std::endl;
-		_MergeSlabs< Real , Dim >( clientPartitionInfo.tempDir , clientPartitionInfo.outDir , clientPartitionInfo.outHeader , clientPartitionInfo.clientCount , slabRange , clientPartitionInfo.slabs , clientPartitionInfo.filesPerDir , factory , clientPartitionInfo.bufferSize );
+		_MergeSlabs< Real , Dim >( clientPartitionInfo.tempDir , clientPartitionInfo.outDir , clientPartitionInfo.outHeader , clientPartitionInfo.clientCount , slabRange , clientPartitionInfo.slabs , clientPartitionInfo.filesPerDir , factory , bufferSize , clientPartitionInfo.directIO );
 		if( clientPartitionInfo.verbose ) std::cout << "Merged slabs: "  << MemoryInfo::PeakMemoryUsageMB() << " (MB)" << std::endl;
 
 		// Notify the server that you're done
@@ -426,7 +504,7 @@ void RunClients( std::vector< Socket > &serverSockets )
 // ClientPartitionInfo //
 /////////////////////////
 template< typename Real >
-ClientPartitionInfo< Real >::ClientPartitionInfo( void ) : scale((Real)1.1) , verbose(false) , slabs(0) , filesPerDir(-1) , bufferSize(BUFFER_IO) , clientCount(0) {}
+ClientPartitionInfo< Real >::ClientPartitionInfo( void ) : scale((Real)1.1) , verbose(false) , slabs(0) , filesPerDir(-1) , bufferSize(BUFFER_IO) , clientCount(0) , memoryMB(0) , directIO(false) , computeStatistics(true) {}
 
 template< typename Real >
 ClientPartitionInfo< Real >::ClientPartitionInfo( BinaryStream &stream )
@@ -448,6 +526,9 @@ ClientPartitionInfo< Real >::ClientPartitionInfo( BinaryStream &stream )
 	if( !stream.read( scale ) ) ERROR_OUT( "Failed to read scale" );
 	if( !stream.read( clientCount ) ) ERROR_OUT( "Failed to read client count" );
 	if( !ReadBool( verbose ) ) ERROR_OUT( "Failed to read verbose flag" );
+	if( !stream.read( memoryMB ) ) ERROR_OUT( "Failed to read memory budget" );
+	if( !ReadBool( directIO ) ) ERROR_OUT( "Failed to read direct I/O flag" );
+	if( !ReadBool( computeStatistics ) ) ERROR_OUT( "Failed to read compute statistics flag" );
 }
 
 template< typename Real >
@@ -468,4 +549,7 @@ void ClientPartitionInfo< Real >::write( BinaryStream &stream ) const
 	stream.write( scale );
 	stream.write( clientCount );
 	WriteBool( verbose );
+	stream.write( memoryMB );
+	WriteBool( directIO );
+	WriteBool( computeStatistics );
 }
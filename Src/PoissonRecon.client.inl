@@ -140,6 +140,10 @@ protected:
 	Client( const ClientReconstructionInfo< Real , Dim > &clientReconInfo , BinaryStream &stream , unsigned int phase );
 	void _write( const ClientReconstructionInfo< Real , Dim > &clientReconInfo , BinaryStream &stream , unsigned int phase ) const;
 
+	// Persists the state at the end of the phase, before anything is sent to the server
+	void _checkpoint( const ClientReconstructionInfo< Real , Dim > &clientReconInfo , unsigned int phase , PhaseInfo &phaseInfo ) const;
+	static Client *_Restore( const ClientReconstructionInfo< Real , Dim > &clientReconInfo , unsigned int index , unsigned int phase , size_t &ioBytes );
+
 	template< typename _Real , unsigned int _Dim , BoundaryType _BType , unsigned int _Degree >
 	friend void RunClient( std::vector< Socket > &serverSockets , unsigned int sampleMS );
 
@@ -163,14 +167,42 @@ void RunClient( std::vector< Socket > &serverSockets , unsigned int sampleMS )
 	if( serverSocketStreams.size()>1 ) for( unsigned int idx=0 ; idx<serverSocketStreams.size() ; idx++ ) cacheFiles.emplace_back( std::tmpfile() );
 
 	Client< Real , Dim , BType , Degree > *client = NULL;
-	if( serverSocketStreams.size()==1 )
+	if( serverSocketStreams.size()==1 && clientReconInfo.resumePhase<=1 )
 	{
 		client = new Client< Real , Dim , BType , Degree >();
 		client->_serverSocket = serverSocketStreams[0];
 		client->_index        = clientIndices[0];
 	}
 
+	// Multiple clients need to be reloaded before every phase, and a single client before the first one that is resumed.
+	// When checkpointing, the checkpoint doubles as the cache.
+	auto LoadClient = [&]( unsigned int i , unsigned int phase , size_t &ioBytes )
+	{
+		if( clientReconInfo.checkpoint ) client = Client< Real , Dim , BType , Degree >::_Restore( clientReconInfo , clientIndices[i] , phase , ioBytes );
+		else
+		{
+			cacheFiles[i].ioBytes = 0;
+			cacheFiles[i].reset();
+			client = new Client< Real , Dim , BType , Degree >( clientReconInfo , cacheFiles[i] , phase );
+			ioBytes += cacheFiles[i].ioBytes;
+		}
+		client->_serverSocket = serverSocketStreams[i];
+	};
+	auto StoreClient = [&]( unsigned int i , unsigned int phase , size_t &ioBytes )
+	{
+		if( !clientReconInfo.checkpoint )
+		{
+			cacheFiles[i].reset();
+			cacheFiles[i].ioBytes = 0;
+			client->_write( clientReconInfo , cacheFiles[i] , phase );
+			ioBytes += cacheFiles[i].ioBytes;
+		}
+		delete client;
+		client = NULL;
+	};
+
 	// Phase 1
+	if( clientReconInfo.resumePhase<=1 )
 	{
 		PhaseInfo phaseInfo;
 		double cacheTime = 0;
@@ -191,14 +223,7 @@ void RunClient( std::vector< Socket > &serverSockets , unsigned int sampleMS )
 			if( serverSocketStreams.size()>1 )
 			{
 				Timer timer;
-
-				cacheFiles[i].reset();
-				cacheFiles[i].ioBytes = 0;
-				client->_write( clientReconInfo , cacheFiles[i] , 1 );
-				cacheBytes += cacheFiles[i].ioBytes;
-				delete client;
-				client = NULL;
-
+				StoreClient( i , 1 , cacheBytes );
 				cacheTime += timer.wallTime();
 			}
 		}
@@ -208,11 +233,13 @@ void RunClient( std::vector< Socket > &serverSockets , unsigned int sampleMS )
 			std::cout << ReceiveDataString( 1 , phaseInfo.readBytes ) << phaseInfo.readTime << " (s)" << std::endl;
 			std::cout << "[PROCESS 1]         : " << phaseInfo.processTime << " (s), " << profiler(false) << std::endl;
 			std::cout << SendDataString( 1 , phaseInfo.writeBytes ) << phaseInfo.writeTime << " (s)" << std::endl;
+			if( clientReconInfo.checkpoint ) std::cout << "[CHECKPOINT 1]      : " << phaseInfo.checkpointTime << " (s) , " << (phaseInfo.checkpointBytes>>20) << " (MB)" << std::endl;
 			if( serverSocketStreams.size()>1 ) std::cout << "[CACHE   1]         : " << cacheTime << " (s) , " << (cacheBytes>>20) << " (MB)" << std::endl;
 		}
 	}
 
 	// Phase 3
+	if( clientReconInfo.resumePhase<=3 )
 	{
 		PhaseInfo phaseInfo;
 		double cacheTime = 0;
@@ -223,15 +250,11 @@ void RunClient( std::vector< Socket > &serverSockets , unsigned int sampleMS )
 		{
 			typename Client< Real , Dim , BType , Degree >::_State3 state3;
 
-			if( serverSocketStreams.size()>1 )
+			if( serverSocketStreams.size()>1 || clientReconInfo.resumePhase==3 )
 			{
 				Timer timer;
-				cacheFiles[i].ioBytes = 0;
-				cacheFiles[i].reset();
-				client = new Client< Real , Dim , BType , Degree >( clientReconInfo , cacheFiles[i] , 3 );
+				LoadClient( i , 3 , cacheBytes );
 				cacheTime += timer.wallTime();
-				cacheBytes += cacheFiles[i].ioBytes;
-				client->_serverSocket = serverSocketStreams[i];
 			}
 
 			phaseInfo += client->_phase3( clientReconInfo , state3 , profiler );
@@ -239,13 +262,8 @@ void RunClient( std::vector< Socket > &serverSockets , unsigned int sampleMS )
 			if( serverSocketStreams.size()>1 )
 			{
 				Timer timer;
-				cacheFiles[i].ioBytes = 0;
-				cacheFiles[i].reset();
-				client->_write( clientReconInfo , cacheFiles[i] , 3 );
-				delete client;
-				client = NULL;
+				StoreClient( i , 3 , cacheBytes );
 				cacheTime += timer.wallTime();
-				cacheBytes += cacheFiles[i].ioBytes;
 			}
 		}
 
@@ -255,11 +273,13 @@ void RunClient( std::vector< Socket > &serverSockets , unsigned int sampleMS )
 			std::cout << ReceiveDataString( 3 , phaseInfo.readBytes ) << phaseInfo.readTime << " (s)" << std::endl;
 			std::cout << "[PROCESS 3]         : " << phaseInfo.processTime << " (s), " << profiler(false) << std::endl;
 			std::cout << SendDataString( 3 , phaseInfo.writeBytes ) << phaseInfo.writeTime << " (s)" << std::endl;
+			if( clientReconInfo.checkpoint ) std::cout << "[CHECKPOINT 3]      : " << phaseInfo.checkpointTime << " (s) , " << (phaseInfo.checkpointBytes>>20) << " (MB)" << std::endl;
 			if( serverSocketStreams.size()>1 ) std::cout << "[CACHE   3]         : " << cacheTime << " (s) , " << (cacheBytes>>20) << " (MB)" << std::endl;
 		}
 	}
 
 	// Phase 5
+	if( clientReconInfo.resumePhase<=5 )
 	{
 		PhaseInfo phaseInfo;
 		double cacheTime = 0;
@@ -268,15 +288,11 @@ void RunClient( std::vector< Socket > &serverSockets , unsigned int sampleMS )
 		profiler.reset();
 		for( unsigned int i=0 ; i<serverSocketStreams.size() ; i++ )
 		{
-			if( serverSocketStreams.size()>1 )
+			if( serverSocketStreams.size()>1 || clientReconInfo.resumePhase==5 )
 			{
 				Timer timer;
-				cacheFiles[i].ioBytes = 0;
-				cacheFiles[i].reset();
-				client = new Client< Real , Dim , BType , Degree >( clientReconInfo , cacheFiles[i] , 5 );
+				LoadClient( i , 5 , cacheBytes );
 				cacheTime += timer.wallTime();
-				cacheBytes += cacheFiles[i].ioBytes;
-				client->_serverSocket = serverSocketStreams[i];
 			}
 
 			phaseInfo += client->_phase5( clientReconInfo , profiler );
@@ -284,13 +300,8 @@ void RunClient( std::vector< Socket > &serverSockets , unsigned int sampleMS )
 			if( serverSocketStreams.size()>1 )
 			{
 				Timer timer;
-				cacheFiles[i].ioBytes;
-				cacheFiles[i].reset();
-				client->_write( clientReconInfo , cacheFiles[i] , 5 );
-				delete client;
-				client = NULL;
+				StoreClient( i , 5 , cacheBytes );
 				cacheTime += timer.wallTime();
-				cacheBytes += cacheFiles[i].ioBytes;
 			}
 		}
 
@@ -300,10 +311,12 @@ void RunClient( std::vector< Socket > &serverSockets , unsigned int sampleMS )
 			std::cout << ReceiveDataString( 5 , phaseInfo.readBytes ) << phaseInfo.readTime << " (s)" << std::endl;
 			std::cout << "[PROCESS 5]         : " << phaseInfo.processTime << " (s), " << profiler(false) << std::endl;
 			std::cout << SendDataString( 5 , phaseInfo.writeBytes ) << phaseInfo.writeTime << " (s)" << std::endl;
+			if( clientReconInfo.checkpoint ) std::cout << "[CHECKPOINT 5]      : " << phaseInfo.checkpointTime << " (s) , " << (phaseInfo.checkpointBytes>>20) << " (MB)" << std::endl;
 			if( serverSocketStreams.size()>1 ) std::cout << "[CACHE   5]         : " << cacheTime << " (s) , " << (cacheBytes>>20) << " (MB)" << std::endl;
 		}
 	}
 	// Phase 7
+	if( clientReconInfo.resumePhase<=7 )
 	{
 		PhaseInfo phaseInfo;
 		double cacheTime = 0;
@@ -312,15 +325,11 @@ void RunClient( std::vector< Socket > &serverSockets , unsigned int sampleMS )
 		profiler.reset();
 		for( unsigned int i=0 ; i<serverSocketStreams.size() ; i++ )
 		{
-			if( serverSocketStreams.size()>1 )
+			if( serverSocketStreams.size()>1 || clientReconInfo.resumePhase==7 )
 			{
 				Timer timer;
-				cacheFiles[i].ioBytes = 0;
-				cacheFiles[i].reset();
-				client = new Client< Real , Dim , BType , Degree >( clientReconInfo , cacheFiles[i] , 7 );
+				LoadClient( i , 7 , cacheBytes );
 				cacheTime += timer.wallTime();
-				cacheBytes += cacheFiles[i].ioBytes;
-				client->_serverSocket = serverSocketStreams[i];
 			}
 
 			phaseInfo += client->_phase7( clientReconInfo , profiler );
@@ -423,6 +432,7 @@ PhaseInfo Client< Real , Dim , BType , Degree >::_phase1( const ClientReconstruc
 		_process1( clientReconInfo , pointDepthAndWeight , nodeCounts , profiler );
 		phaseInfo.processTime += timer.wallTime();
 	}
+	if( clientReconInfo.checkpoint ) _checkpoint( clientReconInfo , 1 , phaseInfo );
 
 	ProjectiveData< Real , Real > pointWeight;
 	pointWeight.data = pointDepthAndWeight.data[1];
@@ -686,6 +696,7 @@ PhaseInfo Client< Real , Dim , BType , Degree >::_phase3( const ClientReconstruc
 		_process3( clientReconInfo , cumulativePointWeight , state3 , profiler );
 		phaseInfo.processTime += timer.wallTime();
 	}
+	if( clientReconInfo.checkpoint ) _checkpoint( clientReconInfo , 3 , phaseInfo );
 
 	{
 		Timer timer;
@@ -940,6 +951,7 @@ PhaseInfo Client< Real , Dim , BType , Degree >::_phase5( const ClientReconstruc
 		isoInfo = _process5( clientReconInfo , state5 , profiler );
 		phaseInfo.processTime += timer.wallTime();
 	}
+	if( clientReconInfo.checkpoint ) _checkpoint( clientReconInfo , 5 , phaseInfo );
 
 	{
 		Timer timer;
@@ -1165,7 +1177,7 @@ PhaseInfo Client< Real , Dim , BType , Degree >::_phase7( const ClientReconstruc
 	PhaseInfo phaseInfo;
 
 	typename Client< Real , Dim , BType , Degree >::_State7 state7;
-	if( clientReconInfo.mergeType!=ClientReconstructionInfo< Real , Dim >::MergeType::NONE )
+	// [NOTE] Even if the slabs are not merged, the server sends the iso-value
 	{
 		Timer timer;
 		phaseInfo.readBytes += _receive7( clientReconInfo , state7 , profiler );
@@ -1544,3 +1556,36 @@ void Client< Real , Dim , BType , Degree >::_write( const ClientReconstructionIn
 		}
 	}
 }
+
+template< typename Real , unsigned int Dim , BoundaryType BType , unsigned int Degree >
+void Client< Real , Dim , BType , Degree >::_checkpoint( const ClientReconstructionInfo< Real , Dim > &clientReconInfo , unsigned int phase , PhaseInfo &phaseInfo ) const
+{
+	Timer timer;
+	std::string fileName = clientReconInfo.clientCheckpointFile( _index , phase );
+	std::string tempFileName = fileName + std::string( ".tmp" );
+	FILE *fp = fopen( tempFileName.c_str() , "wb" );
+	if( !fp ) ERROR_OUT( "Failed to open checkpoint for writing: " , tempFileName );
+	{
+		FileStream fs( fp );
+		_write( clientReconInfo , fs , phase );
+		phaseInfo.checkpointBytes += fs.ioBytes;
+	}
+	fclose( fp );
+	try{ std::filesystem::rename( tempFileName , fileName ); }
+	catch( ... ){ ERROR_OUT( "Failed to rename: " , tempFileName , " -> " , fileName ); }
+	phaseInfo.checkpointTime += timer.wallTime();
+}
+
+template< typename Real , unsigned int Dim , BoundaryType BType , unsigned int Degree >
+Client< Real , Dim , BType , Degree > *Client< Real , Dim , BType , Degree >::_Restore( const ClientReconstructionInfo< Real , Dim > &clientReconInfo , unsigned int index , unsigned int phase , size_t &ioBytes )
+{
+	std::string fileName = clientReconInfo.clientCheckpointFile( index , phase-2 );
+	FILE *fp = fopen( fileName.c_str() , "rb" );
+	if( !fp ) ERROR_OUT( "Failed to open checkpoint for reading: " , fileName );
+	FileStream fs( fp );
+	Client *client = new Client( clientReconInfo , fs , phase );
+	ioBytes += fs.ioBytes;
+	fclose( fp );
+	if( client->_index!=index ) ERROR_OUT( "Checkpoint index does not match: " , client->_index , " != " , index );
+	return client;
+}
@@ -33,6 +33,9 @@ DAMAGE.
 #include <stdlib.h>
 #include <math.h>
 #include <float.h>
+#include <sstream>
+#include <iomanip>
+#include <limits>
 #include "MyMiscellany.h"
 #include "CmdLineParser.h"
 #include "PPolynomial.h"
@@ -66,6 +69,9 @@ cmdLineReadable
 	ExactInterpolation( "exact" ) ,
 	Colors( "colors" ) ,
 	InCore( "inCore" ) ,
+	StreamOutput( "streamOutput" ) ,
+	PipelinedCG( "pipelinedCG" ) ,
+	DirectBaseSolve( "directBaseSolve" ) ,
 	NoDirichletErode( "noErode" ) ,
 	Gradients( "gradients" ) ,
 	Verbose( "verbose" );
@@ -79,12 +85,14 @@ cmdLineParameter< int >
 	SolveDepth( "solveDepth" ) ,
 	EnvelopeDepth( "envelopeDepth" ) ,
 	Iters( "iters" , 8 ) ,
+	VCycles( "vCycles" , 1 ) ,
 	FullDepth( "fullDepth" , 5 ) ,
 	BaseDepth( "baseDepth" ) ,
 	BaseVCycles( "baseVCycles" , 1 ) ,
 #ifndef FAST_COMPILE
 	BType( "bType" , Reconstructor::Poisson::DefaultFEMBoundary+1 ) ,
 #endif // !FAST_COMPILE
+	CGPreconditionerType( "cgPreconditioner" , CG_PRECONDITIONER_NONE ) ,
 	MaxMemoryGB( "maxMemory" , 0 ) ,
 #ifdef _OPENMP
 	ParallelType( "parallel" , (int)ThreadPool::OPEN_MP ) ,
@@ -93,6 +101,7 @@ cmdLineParameter< int >
 #endif // _OPENMP
 	ScheduleType( "schedule" , (int)ThreadPool::DefaultSchedule ) ,
 	ThreadChunkSize( "chunkSize" , (int)ThreadPool::DefaultChunkSize ) ,
+	Quantize( "quantize" , 0 ) ,
 	Threads( "threads" , (int)std::thread::hardware_concurrency() );
 
 cmdLineParameter< float >
@@ -103,6 +112,9 @@ cmdLineParameter< float >
 	Confidence( "confidence" , 0.f ) ,
 	ConfidenceBias( "confidenceBias" , 0.f ) ,
 	CGSolverAccuracy( "cgAccuracy" , 1e-3f ) ,
+	SweepAccuracy( "sweepAccuracy" , 0.f ) ,
+	SweepStagnation( "sweepStagnation" , 0.f ) ,
+	VCycleAccuracy( "vCycleAccuracy" , 0.f ) ,
 	LowDepthCutOff( "lowDepthCutOff" , 0.f ) ,
 	PointWeight( "pointWeight" );
 
@@ -115,7 +127,7 @@ cmdLineReadable* params[] =
 	&SolveDepth ,
 	&Envelope ,
 	&Width ,
-	&Scale , &Verbose , &CGSolverAccuracy ,
+	&Scale , &Verbose , &CGSolverAccuracy , &CGPreconditionerType , &PipelinedCG , &DirectBaseSolve ,
 	&KernelDepth , &SamplesPerNode , &Confidence , &NonManifold , &PolygonMesh , &ASCII , &ShowResidual ,
 	&EnvelopeDepth ,
 	&NoDirichletErode ,
@@ -126,10 +138,12 @@ cmdLineReadable* params[] =
 	&Tree ,
 	&Density ,
 	&FullDepth ,
-	&Iters ,
+	&Iters , &VCycles , &SweepAccuracy , &SweepStagnation , &VCycleAccuracy ,
 	&DataX ,
 	&Colors ,
 	&Gradients ,
+	&Quantize ,
+	&StreamOutput ,
 	&LinearFit ,
 	&PrimalGrid ,
 	&TempDir ,
@@ -168,10 +182,15 @@ void ShowUsage(char* ex)
 	printf( "\t[--%s <minimum number of samples per node>=%f]\n" , SamplesPerNode.name, SamplesPerNode.value );
 	printf( "\t[--%s <interpolation weight>=%.3e * <b-spline degree>]\n" , PointWeight.name , Reconstructor::Poisson::WeightMultiplier * Reconstructor::Poisson::DefaultFEMDegree );
 	printf( "\t[--%s <iterations>=%d]\n" , Iters.name , Iters.value );
+	printf( "\t[--%s <sweep residual reduction (0 = fixed iterations)>=%g]\n" , SweepAccuracy.name , SweepAccuracy.value );
+	printf( "\t[--%s <sweep stagnation ratio (0 = fixed iterations)>=%g]\n" , SweepStagnation.name , SweepStagnation.value );
+	printf( "\t[--%s <v-cycles>=%d]\n" , VCycles.name , VCycles.value );
+	printf( "\t[--%s <v-cycle relative residual (0 = fixed v-cycles)>=%g]\n" , VCycleAccuracy.name , VCycleAccuracy.value );
 	printf( "\t[--%s]\n" , ExactInterpolation.name );
 	printf( "\t[--%s <pull factor>=%f]\n" , DataX.name , DataX.value );
 	printf( "\t[--%s]\n" , Colors.name );
 	printf( "\t[--%s]\n" , Gradients.name );
+	printf( "\t[--%s <position quantization bits (0 = off)>=%d]\n" , Quantize.name , Quantize.value );
 	printf( "\t[--%s <num threads>=%d]\n" , Threads.name , Threads.value );
 	printf( "\t[--%s <parallel type>=%d]\n" , ParallelType.name , ParallelType.value );
 	for( size_t i=0 ; i<ThreadPool::ParallelNames.size() ; i++ ) printf( "\t\t%d] %s\n" , (int)i , ThreadPool::ParallelNames[i].c_str() );
@@ -184,6 +203,10 @@ void ShowUsage(char* ex)
 	printf( "\t[--%s]\n" , NonManifold.name );
 	printf( "\t[--%s]\n" , PolygonMesh.name );
 	printf( "\t[--%s <cg solver accuracy>=%g]\n" , CGSolverAccuracy.name , CGSolverAccuracy.value );
+	printf( "\t[--%s <cg preconditioner>=%d]\n" , CGPreconditionerType.name , CGPreconditionerType.value );
+	for( int i=0 ; i<CG_PRECONDITIONER_COUNT ; i++ ) printf( "\t\t%d] %s\n" , i , CGPreconditionerNames[i] );
+	printf( "\t[--%s]\n" , DirectBaseSolve.name );
+	printf( "\t[--%s]\n" , PipelinedCG.name );
 	printf( "\t[--%s <maximum memory (in GB)>=%d]\n" , MaxMemoryGB.name , MaxMemoryGB.value );
 	printf( "\t[--%s]\n" , NoDirichletErode.name );
 	printf( "\t[--%s]\n" , Performance.name );
@@ -191,78 +214,182 @@ void ShowUsage(char* ex)
 	printf( "\t[--%s]\n" , LinearFit.name );
 	printf( "\t[--%s]\n" , PrimalGrid.name );
 	printf( "\t[--%s]\n" , ASCII.name );
+	printf( "\t[--%s]\n" , StreamOutput.name );
 	printf( "\t[--%s]\n" , TempDir.name );
 	printf( "\t[--%s]\n" , InCore.name );
 	printf( "\t[--%s]\n" , Verbose.name );
 }
 
-template< typename Real , unsigned int Dim , unsigned int FEMSig , bool HasGradients , bool HasDensity >
-void WriteMesh
+// Returns the factory for output positions, quantized relative to the bounding cube of the reconstruction in compact mode
+template< typename PositionFactory , typename Real , unsigned int Dim >
+PositionFactory GetOutputPositionFactory( XForm< Real , Dim+1 > unitCubeToModel , unsigned int quantizationBits , bool hasGradients , std::vector< std::string > &comments )
+{
+	if constexpr( std::is_same< PositionFactory , VertexFactory::PositionFactory< Real , Dim > >::value ) return PositionFactory();
+	else
+	{
+		PositionFactory positionFactory( unitCubeToModel , quantizationBits );
+
+		// Record the de-quantization in the header
+		std::stringstream ss;
+		ss << std::setprecision( std::numeric_limits< double >::max_digits10 );
+		ss << "quantized positions: origin";
+		for( unsigned int d=0 ; d<Dim ; d++ ) ss << " " << positionFactory.origin()[d];
+		ss << " step " << positionFactory.step();
+		comments.push_back( ss.str() );
+		if( hasGradients ) comments.push_back( "octahedral normals: step 1/32767" );
+
+		if( Verbose.set )
+		{
+			std::cout << "Quantization error bound: position " << positionFactory.maxError();
+			if( hasGradients ) std::cout << ", normal " << VertexFactory::OctahedralNormalFactory< Real >::MaxAngularError() << " (radians)";
+			std::cout << std::endl;
+		}
+		return positionFactory;
+	}
+}
+
+template< typename Real , unsigned int Dim , unsigned int FEMSig , bool HasGradients , bool HasDensity , bool Compact >
+void _WriteMesh
 (
 	bool inCore ,
 	Reconstructor::Implicit< Real , Dim , FEMSig > &implicit ,
 	const Reconstructor::LevelSetExtractionParameters &meParams ,
 	std::string fileName ,
-	bool ascii
+	bool ascii ,
+	bool streamOutput ,
+	unsigned int quantizationBits
 )
 {
 	// A description of the output vertex information
-	using VInfo = Reconstructor::OutputVertexInfo< Real , Dim , HasGradients , HasDensity >;
+	using VInfo = Reconstructor::OutputVertexInfo< Real , Dim , HasGradients , HasDensity , Compact >;
 
 	// A factory generating the output vertices
 	using Factory = typename VInfo::Factory;
-	Factory factory = VInfo::GetFactory();
+	std::vector< std::string > comments;
+	Factory factory = VInfo::GetFactory( GetOutputPositionFactory< typename VInfo::PositionFactory , Real , Dim >( implicit.unitCubeToModel , quantizationBits , HasGradients , comments ) );
 
-	// A backing stream for the vertices
-	Reconstructor::OutputInputFactoryTypeStream< Factory > vertexStream( factory , inCore , false , std::string( "v_" ) );
+	// A backing stream for the polygons
 	Reconstructor::OutputInputPolygonStream polygonStream( inCore , true , std::string( "p_" ) );
 
+	if( streamOutput )
 	{
-		// The wrapper converting native to output types
-		typename VInfo::StreamWrapper _vertexStream( vertexStream , factory() );
+		// Vertices are written directly to the .ply file, as they are generated
+		PLY::StreamingPolygonWriter< Factory , node_index_type > vertexStream( fileName , factory , PLY_BINARY_NATIVE , comments );
+		{
+			// The wrapper converting native to output types
+			typename VInfo::StreamWrapper _vertexStream( vertexStream , factory() );
 
-		// Extract the level set
-		implicit.extractLevelSet( _vertexStream , polygonStream , meParams );
+			// Extract the level set
+			implicit.extractLevelSet( _vertexStream , polygonStream , meParams );
+		}
+
+		// Append the polygons to the .ply file
+		vertexStream.writePolygons( polygonStream , polygonStream.size() );
 	}
+	else
+	{
+		// A backing stream for the vertices
+		Reconstructor::OutputInputFactoryTypeStream< Factory > vertexStream( factory , inCore , false , std::string( "v_" ) );
+		{
+			// The wrapper converting native to output types
+			typename VInfo::StreamWrapper _vertexStream( vertexStream , factory() );
+
+			// Extract the level set
+			implicit.extractLevelSet( _vertexStream , polygonStream , meParams );
+		}
 
-	// Write the mesh to a .ply file
-	std::vector< std::string > noComments;
-	PLY::WritePolygons< Factory , node_index_type , Real , Dim >( fileName , factory , vertexStream.size() , polygonStream.size() , vertexStream , polygonStream , ascii ? PLY_ASCII : PLY_BINARY_NATIVE , noComments );
+		// Write the mesh to a .ply file
+		PLY::WritePolygons< Factory , node_index_type , Real , Dim >( fileName , factory , vertexStream.size() , polygonStream.size() , vertexStream , polygonStream , ascii ? PLY_ASCII : PLY_BINARY_NATIVE , comments );
+	}
 }
 
-template< typename Real , unsigned int Dim , unsigned int FEMSig , typename AuxDataFactory , bool HasGradients , bool HasDensity >
-void WriteMeshWithData
+template< typename Real , unsigned int Dim , unsigned int FEMSig , bool HasGradients , bool HasDensity >
+void WriteMesh
+(
+	bool inCore ,
+	Reconstructor::Implicit< Real , Dim , FEMSig > &implicit ,
+	const Reconstructor::LevelSetExtractionParameters &meParams ,
+	std::string fileName ,
+	bool ascii ,
+	bool streamOutput ,
+	unsigned int quantizationBits
+)
+{
+	if( quantizationBits ) _WriteMesh< Real , Dim , FEMSig , HasGradients , HasDensity , true  >( inCore , implicit , meParams , fileName , ascii , streamOutput , quantizationBits );
+	else                   _WriteMesh< Real , Dim , FEMSig , HasGradients , HasDensity , false >( inCore , implicit , meParams , fileName , ascii , streamOutput , quantizationBits );
+}
+
+template< typename Real , unsigned int Dim , unsigned int FEMSig , typename AuxDataFactory , bool HasGradients , bool HasDensity , bool Compact >
+void _WriteMeshWithData
 (
 	const AuxDataFactory &auxDataFactory ,
 	bool inCore ,
 	Reconstructor::Implicit< Real , Dim , FEMSig , typename AuxDataFactory::VertexType > &implicit ,
 	const Reconstructor::LevelSetExtractionParameters &meParams ,
 	std::string fileName ,
-	bool ascii
+	bool ascii ,
+	bool streamOutput ,
+	unsigned int quantizationBits
 )
 {
 	// A description of the output vertex information
-	using VInfo = Reconstructor::OutputVertexWithDataInfo< Real , Dim , AuxDataFactory , HasGradients , HasDensity >;
+	using VInfo = Reconstructor::OutputVertexWithDataInfo< Real , Dim , AuxDataFactory , HasGradients , HasDensity , Compact >;
 
 	// A factory generating the output vertices
 	using Factory = typename VInfo::Factory;
-	Factory factory = VInfo::GetFactory( auxDataFactory );
+	std::vector< std::string > comments;
+	Factory factory = VInfo::GetFactory( auxDataFactory , GetOutputPositionFactory< typename VInfo::PositionFactory , Real , Dim >( implicit.unitCubeToModel , quantizationBits , HasGradients , comments ) );
 
-	// A backing stream for the vertices
-	Reconstructor::OutputInputFactoryTypeStream< Factory > vertexStream( factory , inCore , false , std::string( "v_" ) );
+	// A backing stream for the polygons
 	Reconstructor::OutputInputPolygonStream polygonStream( inCore , true , std::string( "p_" ) );
 
+	if( streamOutput )
+	{
+		// Vertices are written directly to the .ply file, as they are generated
+		PLY::StreamingPolygonWriter< Factory , node_index_type > vertexStream( fileName , factory , PLY_BINARY_NATIVE , comments );
+		{
+			// The wrapper converting native to output types
+			typename VInfo::StreamWrapper _vertexStream( vertexStream , factory() );
+
+			// Extract the level set
+			implicit.extractLevelSet( _vertexStream , polygonStream , meParams );
+		}
+
+		// Append the polygons to the .ply file
+		vertexStream.writePolygons( polygonStream , polygonStream.size() );
+	}
+	else
 	{
-		// The wrapper converting native to output types
-		typename VInfo::StreamWrapper _vertexStream( vertexStream , factory() );
+		// A backing stream for the vertices
+		Reconstructor::OutputInputFactoryTypeStream< Factory > vertexStream( factory , inCore , false , std::string( "v_" ) );
+		{
+			// The wrapper converting native to output types
+			typename VInfo::StreamWrapper _vertexStream( vertexStream , factory() );
+
+			// Extract the level set
+			implicit.extractLevelSet( _vertexStream , polygonStream , meParams );
+		}
 
-		// Extract the level set
-		implicit.extractLevelSet( _vertexStream , polygonStream , meParams );
+		// Write the mesh to a .ply file
+		PLY::WritePolygons< Factory , node_index_type , Real , Dim >( fileName , factory , vertexStream.size() , polygonStream.size() , vertexStream , polygonStream , ascii ? PLY_ASCII : PLY_BINARY_NATIVE , comments );
 	}
+}
 
-	// Write the mesh to a .ply file
-	std::vector< std::string > noComments;
-	PLY::WritePolygons< Factory , node_index_type , Real , Dim >( fileName , factory , vertexStream.size() , polygonStream.size() , vertexStream , polygonStream , ascii ? PLY_ASCII : PLY_BINARY_NATIVE , noComments );
+template< typename Real , unsigned int Dim , unsigned int FEMSig , typename AuxDataFactory , bool HasGradients , bool HasDensity >
+void WriteMeshWithData
+(
+	const AuxDataFactory &auxDataFactory ,
+	bool inCore ,
+	Reconstructor::Implicit< Real , Dim , FEMSig , typename AuxDataFactory::VertexType > &implicit ,
+	const Reconstructor::LevelSetExtractionParameters &meParams ,
+	std::string fileName ,
+	bool ascii ,
+	bool streamOutput ,
+	unsigned int quantizationBits
+)
+{
+	if( quantizationBits ) _WriteMeshWithData< Real , Dim , FEMSig , AuxDataFactory , HasGradients , HasDensity , true  >( auxDataFactory , inCore , implicit , meParams , fileName , ascii , streamOutput , quantizationBits );
+	else                   _WriteMeshWithData< Real , Dim , FEMSig , AuxDataFactory , HasGradients , HasDensity , false >( auxDataFactory , inCore , implicit , meParams , fileName , ascii , streamOutput , quantizationBits );
 }
 
 template< class Real , unsigned int Dim , unsigned int FEMSig , typename AuxDataFactory >
@@ -316,6 +443,8 @@ void Execute( const AuxDataFactory &auxDataFactory )
 	sParams.outputDensity = Density.set;
 	sParams.exactInterpolation = ExactInterpolation.set;
 	sParams.showResidual = ShowResidual.set;
+	sParams.directBaseSolve = DirectBaseSolve.set;
+	sParams.pipelinedCG = PipelinedCG.set;
 	sParams.scale = (Real)Scale.value;
 	sParams.confidence = (Real)Confidence.value;
 	sParams.confidenceBias = (Real)ConfidenceBias.value;
@@ -324,6 +453,7 @@ void Execute( const AuxDataFactory &auxDataFactory )
 	sParams.pointWeight = (Real)PointWeight.value;
 	sParams.samplesPerNode = (Real)SamplesPerNode.value;
 	sParams.cgSolverAccuracy = (Real)CGSolverAccuracy.value;
+	sParams.cgPreconditioner = (unsigned int)CGPreconditionerType.value;
 	sParams.depth = (unsigned int)Depth.value;
 	sParams.baseDepth = (unsigned int)BaseDepth.value;
 	sParams.solveDepth = (unsigned int)SolveDepth.value;
@@ -332,6 +462,10 @@ void Execute( const AuxDataFactory &auxDataFactory )
 	sParams.envelopeDepth = (unsigned int)EnvelopeDepth.value;
 	sParams.baseVCycles = (unsigned int)BaseVCycles.value;
 	sParams.iters = (unsigned int)Iters.value;
+	sParams.vCycles = (unsigned int)VCycles.value;
+	sParams.sweepAccuracy = (Real)SweepAccuracy.value;
+	sParams.sweepStagnation = (Real)SweepStagnation.value;
+	sParams.vCycleAccuracy = (Real)VCycleAccuracy.value;
 
 	meParams.linearFit = LinearFit.set;
 	meParams.outputGradients = Gradients.set;
@@ -536,26 +670,26 @@ void Execute( const AuxDataFactory &auxDataFactory )
 		{
 			if( Density.set )
 			{
-				if constexpr( HasAuxData ) WriteMeshWithData< Real , Dim , FEMSig , AuxDataFactory , true , true >( auxDataFactory , InCore.set , *implicit , meParams , Out.value , ASCII.set );
-				else                       WriteMesh        < Real , Dim , FEMSig ,                  true , true >(                  InCore.set , *implicit , meParams , Out.value , ASCII.set );
+				if constexpr( HasAuxData ) WriteMeshWithData< Real , Dim , FEMSig , AuxDataFactory , true , true >( auxDataFactory , InCore.set , *implicit , meParams , Out.value , ASCII.set , StreamOutput.set , Quantize.value>0 ? (unsigned int)Quantize.value : 0 );
+				else                       WriteMesh        < Real , Dim , FEMSig ,                  true , true >(                  InCore.set , *implicit , meParams , Out.value , ASCII.set , StreamOutput.set , Quantize.value>0 ? (unsigned int)Quantize.value : 0 );
 			}
 			else
 			{
-				if constexpr( HasAuxData ) WriteMeshWithData< Real , Dim , FEMSig , AuxDataFactory , true , false >( auxDataFactory , InCore.set , *implicit , meParams , Out.value , ASCII.set );
-				else                       WriteMesh        < Real , Dim , FEMSig ,                  true , false >(                  InCore.set , *implicit , meParams , Out.value , ASCII.set );
+				if constexpr( HasAuxData ) WriteMeshWithData< Real , Dim , FEMSig , AuxDataFactory , true , false >( auxDataFactory , InCore.set , *implicit , meParams , Out.value , ASCII.set , StreamOutput.set , Quantize.value>0 ? (unsigned int)Quantize.value : 0 );
+				else                       WriteMesh        < Real , Dim , FEMSig ,                  true , false >(                  InCore.set , *implicit , meParams , Out.value , ASCII.set , StreamOutput.set , Quantize.value>0 ? (unsigned int)Quantize.value : 0 );
 			}
 		}
 		else
 		{
 			if( Density.set )
 			{
-				if constexpr( HasAuxData ) WriteMeshWithData< Real , Dim , FEMSig , AuxDataFactory , false , true >( auxDataFactory , InCore.set , *implicit , meParams , Out.value , ASCII.set );
-				else                       WriteMesh        < Real , Dim , FEMSig ,                  false , true >(                  InCore.set , *implicit , meParams , Out.value , ASCII.set );
+				if constexpr( HasAuxData ) WriteMeshWithData< Real , Dim , FEMSig , AuxDataFactory , false , true >( auxDataFactory , InCore.set , *implicit , meParams , Out.value , ASCII.set , StreamOutput.set , Quantize.value>0 ? (unsigned int)Quantize.value : 0 );
+				else                       WriteMesh        < Real , Dim , FEMSig ,                  false , true >(                  InCore.set , *implicit , meParams , Out.value , ASCII.set , StreamOutput.set , Quantize.value>0 ? (unsigned int)Quantize.value : 0 );
 			}
 			else
 			{
-				if constexpr( HasAuxData ) WriteMeshWithData< Real , Dim , FEMSig , AuxDataFactory , false , false >( auxDataFactory , InCore.set , *implicit , meParams , Out.value , ASCII.set );
-				else                       WriteMesh        < Real , Dim , FEMSig ,                  false , false >(                  InCore.set , *implicit , meParams , Out.value , ASCII.set );
+				if constexpr( HasAuxData ) WriteMeshWithData< Real , Dim , FEMSig , AuxDataFactory , false , false >( auxDataFactory , InCore.set , *implicit , meParams , Out.value , ASCII.set , StreamOutput.set , Quantize.value>0 ? (unsigned int)Quantize.value : 0 );
+				else                       WriteMesh        < Real , Dim , FEMSig ,                  false , false >(                  InCore.set , *implicit , meParams , Out.value , ASCII.set , StreamOutput.set , Quantize.value>0 ? (unsigned int)Quantize.value : 0 );
 			}
 		}
 	}
@@ -608,6 +742,12 @@ int main( int argc , char* argv[] )
 		return 0;
 	}
 
+	if( StreamOutput.set && ASCII.set )
+	{
+		WARN( "Streamed output is only supported for binary files, disabling " , StreamOutput.name );
+		StreamOutput.set = false;
+	}
+
 	if( !BaseDepth.set ) BaseDepth.value = FullDepth.value;
 	if( !SolveDepth.set ) SolveDepth.value = Depth.value;
 
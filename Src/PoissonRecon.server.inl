@@ -80,8 +80,11 @@ protected:
 	PhaseInfo _phase4( const ClientReconstructionInfo< Real , Dim > &clientReconInfo , ProjectiveData< Real , Real > cumulativePointWeight , unsigned int baseVCycles , Real &isoValue , Profiler &profiler );
 	PhaseInfo _phase6( const ClientReconstructionInfo< Real , Dim > &clientReconInfo , Real isoValue , bool showDiscontinuity , bool outputBoundarySlices , std::vector< unsigned int > &sharedVertexCounts , Profiler &profiler );
 
+	Real _receiveIsoValue( const ClientReconstructionInfo< Real , Dim > &clientReconInfo );
+	PhaseInfo _replay( const ClientReconstructionInfo< Real , Dim > &clientReconInfo , unsigned int phase );
+
 	template< typename _Real , unsigned int _Dim , BoundaryType _BType , unsigned int _Degree >
-	friend std::vector< unsigned int > RunServer( PointPartition::PointSetInfo< _Real , _Dim > , PointPartition::Partition , std::vector< Socket > , ClientReconstructionInfo< _Real , _Dim > , unsigned int , unsigned int , bool , bool );
+	friend std::vector< unsigned int > RunServer( PointPartition::PointSetInfo< _Real , _Dim > , PointPartition::Partition , std::vector< Socket > , ClientReconstructionInfo< _Real , _Dim > , unsigned int , unsigned int , bool , bool , Checkpoint< _Real , _Dim > * );
 };
 
 
@@ -95,7 +98,8 @@ std::vector< unsigned int > RunServer
 	unsigned int baseVCycles , 
 	unsigned int sampleMS ,
 	bool showDiscontinuity ,
-	bool outputBoundarySlices
+	bool outputBoundarySlices ,
+	Checkpoint< Real , Dim > *checkpoint
 )
 {
 	std::vector< unsigned int > sharedVertexCounts;
@@ -103,6 +107,10 @@ std::vector< unsigned int > RunServer
 	Profiler profiler( sampleMS );
 
 	clientReconInfo.auxProperties = pointSetInfo.auxiliaryProperties;
+	clientReconInfo.checkpoint = checkpoint!=NULL;
+	clientReconInfo.resumePhase = checkpoint ? checkpoint->phase : 0;
+	if( clientReconInfo.resumePhase>7 ) ERROR_OUT( "Reconstruction has already completed" );
+	if( clientReconInfo.resumePhase>1 && clientReconInfo.verbose>0 ) std::cout << "Resuming from phase: " << clientReconInfo.resumePhase << std::endl;
 
 	// Initialization
 	{
@@ -137,7 +145,21 @@ std::vector< unsigned int > RunServer
 	ProjectiveData< Real , Real > cumulativePointWeight;
 	Real isoValue;
 
+	if( checkpoint ) cumulativePointWeight = checkpoint->cumulativePointWeight , sharedVertexCounts = checkpoint->sharedVertexCounts;
+
+	// Re-send the data from the last completed server phase
+	if( clientReconInfo.resumePhase>1 )
+	{
+		PhaseInfo phaseInfo = server._replay( clientReconInfo , clientReconInfo.resumePhase-1 );
+		if( clientReconInfo.verbose>0 )
+		{
+			StreamFloatPrecision sfp( std::cout , 1 );
+			std::cout << SendDataString( clientReconInfo.resumePhase-1 , phaseInfo.writeBytes ) << phaseInfo.writeTime << " (s)" << std::endl;
+		}
+	}
+
 	// [PHASE 0] Send the client initial information
+	if( clientReconInfo.resumePhase<=1 )
 	{
 		profiler.reset();
 		PhaseInfo phaseInfo = server._phase0( clientReconInfo , profiler );
@@ -149,6 +171,7 @@ std::vector< unsigned int > RunServer
 	}
 
 	// [PHASE 2] Accumulate/Send the point weight
+	if( clientReconInfo.resumePhase<=1 )
 	{
 		profiler.reset();
 		PhaseInfo phaseInfo = server._phase2( clientReconInfo , cumulativePointWeight , profiler );
@@ -159,9 +182,15 @@ std::vector< unsigned int > RunServer
 			std::cout << "[PROCESS 2]         : " << phaseInfo.processTime << " (s), " << profiler(false) << std::endl;
 			std::cout << SendDataString( 2 , phaseInfo.writeBytes ) << phaseInfo.writeTime << " (s)" << std::endl;
 		}
+		if( checkpoint )
+		{
+			checkpoint->cumulativePointWeight = cumulativePointWeight;
+			checkpoint->advance( clientReconInfo.tempDir , clientReconInfo.header , 3 );
+		}
 	}
 
 	// [PHASE 4] Accumulate/solve/send coarse system
+	if( clientReconInfo.resumePhase<=3 )
 	{
 		profiler.reset();
 		PhaseInfo phaseInfo = server._phase4( clientReconInfo , cumulativePointWeight , baseVCycles , isoValue , profiler );
@@ -172,9 +201,13 @@ std::vector< unsigned int > RunServer
 			std::cout << "[PROCESS 4]         : " << phaseInfo.processTime << " (s), " << profiler(false) << std::endl;
 			std::cout << SendDataString( 4 , phaseInfo.writeBytes ) << phaseInfo.writeTime << " (s)" << std::endl;
 		}
+		if( checkpoint ) checkpoint->advance( clientReconInfo.tempDir , clientReconInfo.header , 5 );
 	}
+	// The iso-value is computed by the clients at the start of phase 5
+	else if( clientReconInfo.resumePhase==5 ) isoValue = server._receiveIsoValue( clientReconInfo );
 
 	// [PHASE 6] Accumulate/merge/send boundary tree info
+	if( clientReconInfo.resumePhase<=5 )
 	{
 		profiler.reset();
 		PhaseInfo phaseInfo = server._phase6( clientReconInfo , isoValue , showDiscontinuity , outputBoundarySlices , sharedVertexCounts , profiler );
@@ -185,10 +218,53 @@ std::vector< unsigned int > RunServer
 			std::cout << "[PROCESS 6]         : " << phaseInfo.processTime << " (s), " << profiler(false) << std::endl;
 			std::cout << SendDataString( 6 , phaseInfo.writeBytes ) << phaseInfo.writeTime << " (s)" << std::endl;
 		}
+		if( checkpoint )
+		{
+			checkpoint->sharedVertexCounts = sharedVertexCounts;
+			checkpoint->advance( clientReconInfo.tempDir , clientReconInfo.header , 7 );
+		}
 	}
 	return sharedVertexCounts;
 }
 
+template< typename Real , unsigned int Dim , BoundaryType BType , unsigned int Degree >
+Real Server< Real , Dim , BType , Degree >::_receiveIsoValue( const ClientReconstructionInfo< Real , Dim > &clientReconInfo )
+{
+	std::pair< double , double > isoInfo(0.,0.);
+	for( unsigned int i=0 ; i<_clientSockets.size() ; i++ )
+	{
+		std::pair< double , double > _isoInfo(0.,0.);
+		_clientSockets[i].read( _isoInfo );
+		isoInfo.first += _isoInfo.first;
+		isoInfo.second += _isoInfo.second;
+	}
+	if( clientReconInfo.verbose>1 ) std::cout << "Iso-value: " << ( isoInfo.first / isoInfo.second ) << std::endl;
+	return (Real)( isoInfo.first / isoInfo.second );
+}
+
+template< typename Real , unsigned int Dim , BoundaryType BType , unsigned int Degree >
+PhaseInfo Server< Real , Dim , BType , Degree >::_replay( const ClientReconstructionInfo< Real , Dim > &clientReconInfo , unsigned int phase )
+{
+	using ShareType = typename ClientReconstructionInfo< Real , Dim >::ShareType;
+	PhaseInfo phaseInfo;
+	Timer timer;
+
+	// Data is re-sent in the same order as it was originally sent
+	if( phase==2 || phase==4 )
+		for( unsigned int i=0 ; i<_clientSockets.size() ; i++ )
+			phaseInfo.writeBytes += ClientServerStream< false >::Replay( _clientSockets[i] , i , clientReconInfo , ShareType::CENTER , clientReconInfo.serverCheckpointFile( i , phase ) );
+	else if( phase==6 )
+		for( unsigned int i=0 ; i<_clientSockets.size()-1 ; i++ )
+		{
+			phaseInfo.writeBytes += ClientServerStream< false >::Replay( _clientSockets[i+0] , i+0 , clientReconInfo , ShareType::FRONT , clientReconInfo.serverCheckpointFile( i+0 , phase , ShareType::FRONT ) );
+			phaseInfo.writeBytes += ClientServerStream< false >::Replay( _clientSockets[i+1] , i+1 , clientReconInfo , ShareType::BACK  , clientReconInfo.serverCheckpointFile( i+1 , phase , ShareType::BACK  ) );
+		}
+	else ERROR_OUT( "Only phases 2, 4, and 6 can be replayed: " , phase );
+
+	phaseInfo.writeTime += timer.wallTime();
+	return phaseInfo;
+}
+
 template< typename Real , unsigned int Dim , BoundaryType BType , unsigned int Degree >
 PhaseInfo Server< Real , Dim , BType , Degree >::_phase0( const ClientReconstructionInfo< Real , Dim > &clientReconInfo , Profiler &profiler )
 {
@@ -251,6 +327,7 @@ PhaseInfo Server< Real , Dim , BType , Degree >::_phase2( const ClientReconstruc
 	for( unsigned int i=0 ; i<_clientSockets.size() ; i++ )
 	{
 		ClientServerStream< false > clientStream( _clientSockets[i] , i , clientReconInfo );
+		if( clientReconInfo.checkpoint ) clientStream.checkpoint( clientReconInfo.serverCheckpointFile( i , 2 ) );
 		clientStream.ioBytes = 0;
 		clientStream.write( cumulativePointWeight );
 		phaseInfo.writeBytes += clientStream.ioBytes;
@@ -473,6 +550,7 @@ PhaseInfo Server< Real , Dim , BType , Degree >::_phase4( const ClientReconstruc
 #endif // ADAPTIVE_PADDING
 
 		ClientServerStream< false > clientStream( _clientSockets[i] , i , clientReconInfo );
+		if( clientReconInfo.checkpoint ) clientStream.checkpoint( clientReconInfo.serverCheckpointFile( i , 4 ) );
 		clientStream.ioBytes = 0;
 		auto keepNodeFunctor = [&]( const FEMTreeNode *node )
 		{
@@ -553,18 +631,7 @@ PhaseInfo Server< Real , Dim , BType , Degree >::_phase4( const ClientReconstruc
 		phaseInfo.writeBytes += clientStream.ioBytes;
 	}
 
-	{
-		std::pair< double , double > isoInfo(0.,0.);
-		for( unsigned int i=0 ; i<_clientSockets.size() ; i++ )
-		{
-			std::pair< double , double > _isoInfo(0.,0.);
-			_clientSockets[i].read( _isoInfo );
-			isoInfo.first += _isoInfo.first;
-			isoInfo.second += _isoInfo.second;
-		}
-		if( clientReconInfo.verbose>1 ) std::cout << "Iso-value: " << ( isoInfo.first / isoInfo.second ) << std::endl;
-		isoValue = (Real)( isoInfo.first / isoInfo.second );
-	}
+	isoValue = _receiveIsoValue( clientReconInfo );
 
 	return phaseInfo;
 }
@@ -717,6 +784,11 @@ PhaseInfo Server< Real , Dim , BType , Degree >::_phase6( const ClientReconstruc
 			Timer timer;
 			ClientServerStream< false > clientStream0( _clientSockets[i+0] , i+0 , clientReconInfo , ClientReconstructionInfo< Real , Dim >::FRONT );
 			ClientServerStream< false > clientStream1( _clientSockets[i+1] , i+1 , clientReconInfo , ClientReconstructionInfo< Real , Dim >::BACK  );
+			if( clientReconInfo.checkpoint )
+			{
+				clientStream0.checkpoint( clientReconInfo.serverCheckpointFile( i+0 , 6 , ClientReconstructionInfo< Real , Dim >::FRONT ) );
+				clientStream1.checkpoint( clientReconInfo.serverCheckpointFile( i+1 , 6 , ClientReconstructionInfo< Real , Dim >::BACK  ) );
+			}
 			clientStream0.ioBytes = 0;
 			clientStream1.ioBytes = 0;
 			clientStream0.write( isoValue );
@@ -58,10 +58,13 @@ cmdLineParameter< int >
 	Threads( "threads" , (int)std::thread::hardware_concurrency() ) ,
 	MultiClient( "multi" , 1 ) ,
 	Port( "port" , 0 ) ,
-	PeakMemorySampleMS( "sampleMS" , 10 );
+	PeakMemorySampleMS( "sampleMS" , 10 ) ,
+	SocketBufferSize( "socketBuffer" , 0 ) ,
+	SocketBatchSize( "socketBatch" , (int)SocketOptions().batchSize );
 
 cmdLineReadable
-	Pause( "pause" );
+	Pause( "pause" ) ,
+	AsyncReceive( "asyncReceive" );
 
 
 cmdLineReadable* params[] =
@@ -70,6 +73,7 @@ cmdLineReadable* params[] =
 	&MaxMemoryGB , &ParallelType , &ScheduleType , &ThreadChunkSize , &Threads ,
 	&Pause ,
 	&PeakMemorySampleMS ,
+	&SocketBufferSize , &SocketBatchSize , &AsyncReceive ,
 	NULL
 };
 
@@ -87,6 +91,9 @@ void ShowUsage( char* ex )
 	printf( "\t[--%s <thread chunk size>=%d]\n" , ThreadChunkSize.name , ThreadChunkSize.value );
 	printf( "\t[--%s <peak memory sampling rate (ms)>=%d]\n" , PeakMemorySampleMS.name , PeakMemorySampleMS.value );
 	printf( "\t[--%s <maximum memory (in GB)>=%d]\n" , MaxMemoryGB.name , MaxMemoryGB.value );
+	printf( "\t[--%s <socket send/receive buffer size (in bytes)>=%d]\n" , SocketBufferSize.name , SocketBufferSize.value );
+	printf( "\t[--%s <socket write batch size (in bytes)>=%d]\n" , SocketBatchSize.name , SocketBatchSize.value );
+	printf( "\t[--%s]\n" , AsyncReceive.name );
 	printf( "\t[--%s]\n" , Pause.name );
 }
 
@@ -179,18 +186,28 @@ int main( int argc , char* argv[] )
 	ThreadPool::DefaultChunkSize = ThreadChunkSize.value;
 	ThreadPool::DefaultSchedule = (ThreadPool::ScheduleType)ScheduleType.value;
 	ThreadPool::Init( (ThreadPool::ParallelType)ParallelType.value , Threads.value );
+	DefaultSocketOptions().bufferSize = SocketBufferSize.value;
+	DefaultSocketOptions().batchSize = (size_t)std::max< int >( SocketBatchSize.value , 0 );
+	DefaultSocketOptions().asyncReceive = AsyncReceive.set;
 
 	std::vector< Socket > serverSockets( MultiClient.value , NULL );
 	for( unsigned int i=0 ; i<(unsigned int)MultiClient.value ; i++ ) serverSockets[i] = GetConnectSocket( Address.value.c_str() , Port.value , SOCKET_CONNECT_WAIT , false );
 
 	{
-		Partition< Real , Dim >( serverSockets );
+		// The phase at which the server (re)starts the pipeline
+		unsigned int resumePhase;
+		for( unsigned int i=0 ; i<serverSockets.size() ; i++ ) if( !SocketStream( serverSockets[i] ).read( resumePhase ) ) ERROR_OUT( "Failed to read resume phase" );
 
+		if( resumePhase<1 ) Partition< Real , Dim >( serverSockets );
+
+		if( resumePhase<8 )
+		{
 #ifdef FAST_COMPILE
-		Reconstruct< Real , Dim , Reconstructor::Poisson::DefaultFEMBoundary , Reconstructor::Poisson::DefaultFEMDegree >( serverSockets );
+			Reconstruct< Real , Dim , Reconstructor::Poisson::DefaultFEMBoundary , Reconstructor::Poisson::DefaultFEMDegree >( serverSockets );
 #else // !FAST_COMPILE
-		Reconstruct< Real , Dim >( serverSockets );
+			Reconstruct< Real , Dim >( serverSockets );
 #endif // FAST_COMPILE
+		}
 
 		Merge< Real , Dim >( serverSockets );
 
@@ -62,7 +62,8 @@ namespace PoissonReconClientServer
 		unsigned int solveDepth , reconstructionDepth , sharedDepth , distributionDepth , baseDepth , kernelDepth , iters , bufferSize , filesPerDir , padSize , verbose;
 		Real pointWeight , confidence , confidenceBias , samplesPerNode , dataX , cgSolverAccuracy;
 		MergeType mergeType;
-		bool density , linearFit , ouputVoxelGrid;
+		bool density , linearFit , ouputVoxelGrid , checkpoint;
+		unsigned int resumePhase;
 		std::vector< PlyProperty > auxProperties;
 
 		ClientReconstructionInfo( void );
@@ -71,6 +72,40 @@ namespace PoissonReconClientServer
 		void write( BinaryStream &stream ) const;
 
 		std::string sharedFile( unsigned int idx , ShareType shareType=CENTER ) const;
+
+		// The state of client idx after (client) phase
+		std::string clientCheckpointFile( unsigned int idx , unsigned int phase ) const;
+		// The data sent to client idx in (server) phase
+		std::string serverCheckpointFile( unsigned int idx , unsigned int phase , ShareType shareType=CENTER ) const;
+	};
+
+	// The server-side state needed to restart a distributed reconstruction.
+	// The manifest is written last, so a checkpoint is valid if and only if the manifest can be read.
+	// phase is the first phase that still needs to be run:
+	//		0: partition the points
+	//		1: start the reconstruction (the points have been partitioned)
+	//		3, 5, 7: start the reconstruction at the specified client phase
+	//		8: merge the slabs (the reconstruction has completed)
+	template< typename Real , unsigned int Dim >
+	struct Checkpoint
+	{
+		unsigned int clientCount , phase;
+		PointPartition::PointSetInfo< Real , Dim > pointSetInfo;
+		PointPartition::Partition pointPartition;
+		ProjectiveData< Real , Real > cumulativePointWeight;
+		std::vector< unsigned int > sharedVertexCounts;
+
+		Checkpoint( void ) : clientCount(0) , phase(0) , cumulativePointWeight( (Real)0. ) {}
+
+		bool read( std::string tempDir , std::string header );
+		void write( std::string tempDir , std::string header ) const;
+
+		// Commits the checkpoint for the new phase and removes the files that were only needed to restart the previous one
+		void advance( std::string tempDir , std::string header , unsigned int phase );
+
+		static std::string ManifestFile( std::string tempDir , std::string header );
+		static std::string StateFile( std::string tempDir , std::string header );
+		static void Remove( std::string tempDir , std::string header );
 	};
 
 	template< typename Real , unsigned int Dim , BoundaryType BType , unsigned int Degree >
@@ -83,7 +118,8 @@ namespace PoissonReconClientServer
 		unsigned int baseVCycles , 
 		unsigned int sampleMS ,
 		bool showDiscontinuity=false ,
-		bool outputBoundarySlices=false
+		bool outputBoundarySlices=false ,
+		Checkpoint< Real , Dim > *checkpoint=NULL
 	);
 
 	template< typename Real , unsigned int Dim , BoundaryType BType , unsigned int Degree >
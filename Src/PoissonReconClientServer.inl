@@ -216,7 +216,7 @@ struct ClientServerStream : BinaryStream
 		}
 	}
 
-	ClientServerStream( ClientServerStream &&css ) : _socket( std::move( css )._socket ) , _fs( std::move( css )._fs ) , _fileName( std::move( css )._fileName ) {}
+	ClientServerStream( ClientServerStream &&css ) : _socket( std::move( css )._socket ) , _fs( std::move( css )._fs ) , _fileName( std::move( css )._fileName ) , _checkpointFileName( std::move( css )._checkpointFileName ) {}
 
 	template< typename Real , unsigned int Dim >
 	ClientServerStream( SocketStream &socket , unsigned int idx , const ClientReconstructionInfo< Real , Dim > &clientReconInfo , typename ClientReconstructionInfo< Real , Dim >::ShareType shareType = ClientReconstructionInfo< Real , Dim >::CENTER , unsigned int maxTries=-1 )
@@ -260,6 +260,8 @@ struct ClientServerStream : BinaryStream
 				fs.open( fileName , std::ios::in | std::ios::binary );
 				return !fs.is_open();
 			};
+			// The reader removes the file once it has been consumed, so make sure pending messages have gone out before waiting
+			if( !validFile( _fileName ) ) _Socket::FlushAll();
 			unsigned int tries=0;
 			while( !validFile( _fileName ) && tries<maxTries )
 			{
@@ -276,13 +278,48 @@ struct ClientServerStream : BinaryStream
 	{
 		_fs.close();
 		if( ReadFromFile ) std::remove( _fileName.c_str() );
-		else _socket.write( ioBytes );
+		else
+		{
+			// Persist a copy before the size is sent, since the reader removes the file once it is consumed
+			if( _checkpointFileName.length() )
+			{
+				std::string tempFileName = _checkpointFileName + std::string( ".tmp" );
+				try
+				{
+					std::filesystem::copy_file( _fileName , tempFileName , std::filesystem::copy_options::overwrite_existing );
+					std::filesystem::rename( tempFileName , _checkpointFileName );
+				}
+				catch( ... ){ ERROR_OUT( "Failed to checkpoint: " , _fileName , " -> " , _checkpointFileName ); }
+			}
+			_socket.write( ioBytes );
+			_socket.flush();
+		}
+	}
+
+	// Keep a copy of the data written to the stream so that it can be replayed on restart
+	void checkpoint( std::string fileName ){ if constexpr( !ReadFromFile ) _checkpointFileName = fileName; }
+
+	// Re-send data that was checkpointed by an earlier run
+	template< typename Real , unsigned int Dim >
+	static size_t Replay( SocketStream &socket , unsigned int idx , const ClientReconstructionInfo< Real , Dim > &clientReconInfo , typename ClientReconstructionInfo< Real , Dim >::ShareType shareType , std::string checkpointFileName )
+	{
+		static_assert( !ReadFromFile , "[ERROR] Replay requires a writing stream" );
+		std::ifstream fs;
+		fs.open( checkpointFileName , std::ios::in | std::ios::binary );
+		if( !fs.is_open() ) ERROR_OUT( "Failed to open checkpoint for reading: " , checkpointFileName );
+
+		ClientServerStream< false > stream( socket , idx , clientReconInfo , shareType );
+		stream.ioBytes = 0;
+		std::vector< char > buffer( clientReconInfo.bufferSize );
+		while( fs.read( &buffer[0] , buffer.size() ) || fs.gcount() )
+			if( !stream.write( GetPointer( buffer ) , (size_t)fs.gcount() ) ) ERROR_OUT( "Failed to replay checkpoint: " , checkpointFileName );
+		return stream.ioBytes;
 	}
 
 protected:
 	typename std::conditional< ReadFromFile , std::ifstream , std::ofstream >::type _fs;
 	SocketStream &_socket;
-	std::string _fileName;
+	std::string _fileName , _checkpointFileName;
 
 	bool _read( Pointer( unsigned char ) ptr , size_t sz )
 	{
@@ -298,10 +335,10 @@ protected:
 
 struct PhaseInfo
 {
-	double processTime , readTime , writeTime;
-	size_t readBytes , writeBytes;
+	double processTime , readTime , writeTime , checkpointTime;
+	size_t readBytes , writeBytes , checkpointBytes;
 
-	PhaseInfo( void ) : processTime(0) , readTime(0) , writeTime(0) , readBytes(0) , writeBytes(0) {}
+	PhaseInfo( void ) : processTime(0) , readTime(0) , writeTime(0) , checkpointTime(0) , readBytes(0) , writeBytes(0) , checkpointBytes(0) {}
 
 	PhaseInfo &operator += ( const PhaseInfo &pi )
 	{
@@ -309,6 +346,8 @@ struct PhaseInfo
 		readTime    += pi.readTime;
 		readBytes   += pi.readBytes;
 		writeBytes  += pi.writeBytes;
+		checkpointTime  += pi.checkpointTime;
+		checkpointBytes += pi.checkpointBytes;
 		return *this;
 	}
 };
@@ -328,6 +367,8 @@ ClientReconstructionInfo< Real , Dim >::ClientReconstructionInfo( void )
 	dataX = (Real)32.;
 	density = false;
 	linearFit = false;
+	checkpoint = false;
+	resumePhase = 0;
 	mergeType = MergeType::TOPOLOGY_AND_FUNCTION;
 	bufferSize = BUFFER_IO;
 	filesPerDir = -1;
@@ -368,6 +409,8 @@ ClientReconstructionInfo< Real , Dim >::ClientReconstructionInfo( BinaryStream &
 	if( !ReadBool( density ) ) ERROR_OUT( "Failed to read density flag" );
 	if( !ReadBool( linearFit ) ) ERROR_OUT( "Failed to read linear-fit flag" );
 	if( !ReadBool( ouputVoxelGrid ) ) ERROR_OUT( "Failed to read output-voxel-grid flag" );
+	if( !ReadBool( checkpoint ) ) ERROR_OUT( "Failed to read checkpoint flag" );
+	if( !stream.read( resumePhase ) ) ERROR_OUT( "Failed to read resume phase" );
 	{
 		size_t sz;
 		if( !stream.read( sz ) ) ERROR_OUT( "Failed to read number of auxiliary properties" );
@@ -409,6 +452,8 @@ void ClientReconstructionInfo< Real , Dim >::write( BinaryStream &stream ) const
 	WriteBool( density );
 	WriteBool( linearFit );
 	WriteBool( ouputVoxelGrid );
+	WriteBool( checkpoint );
+	stream.write( resumePhase );
 	{
 		size_t sz = auxProperties.size();
 		stream.write( sz );
@@ -430,3 +475,117 @@ std::string ClientReconstructionInfo< Real , Dim >::sharedFile( unsigned int idx
 	return sStream.str();
 }
 
+template< typename Real , unsigned int Dim >
+std::string ClientReconstructionInfo< Real , Dim >::clientCheckpointFile( unsigned int idx , unsigned int phase ) const
+{
+	std::stringstream sStream;
+	sStream << PointPartition::FileDir( tempDir , header ) << "." << idx << "." << phase << ".client";
+	return sStream.str();
+}
+
+template< typename Real , unsigned int Dim >
+std::string ClientReconstructionInfo< Real , Dim >::serverCheckpointFile( unsigned int idx , unsigned int phase , ShareType shareType ) const
+{
+	std::stringstream sStream;
+	switch( shareType )
+	{
+	case BACK:   sStream << PointPartition::FileDir( tempDir , header ) << "." << idx << "." << phase << ".back.server"  ; break;
+	case CENTER: sStream << PointPartition::FileDir( tempDir , header ) << "." << idx << "." << phase << ".server"       ; break;
+	case FRONT:  sStream << PointPartition::FileDir( tempDir , header ) << "." << idx << "." << phase << ".front.server" ; break;
+	default: ERROR_OUT( "Unrecognized share type: " , shareType );
+	}
+	return sStream.str();
+}
+
+////////////////
+// Checkpoint //
+////////////////
+template< typename Real , unsigned int Dim >
+std::string Checkpoint< Real , Dim >::ManifestFile( std::string tempDir , std::string header ){ return PointPartition::FileDir( tempDir , header ) + std::string( ".manifest" ); }
+
+template< typename Real , unsigned int Dim >
+std::string Checkpoint< Real , Dim >::StateFile( std::string tempDir , std::string header ){ return PointPartition::FileDir( tempDir , header ) + std::string( ".server" ); }
+
+template< typename Real , unsigned int Dim >
+bool Checkpoint< Real , Dim >::read( std::string tempDir , std::string header )
+{
+	{
+		std::ifstream fs( ManifestFile( tempDir , header ) );
+		if( !fs.is_open() ) return false;
+		std::string name;
+		if( !( fs >> name >> clientCount ) || name!=std::string( "clients" ) ) ERROR_OUT( "Failed to read client count from manifest" );
+		if( !( fs >> name >> phase ) || name!=std::string( "phase" ) ) ERROR_OUT( "Failed to read phase from manifest" );
+	}
+	{
+		FILE *fp = fopen( StateFile( tempDir , header ).c_str() , "rb" );
+		if( !fp ) ERROR_OUT( "Failed to open checkpoint state for reading: " , StateFile( tempDir , header ) );
+		FileStream fs( fp );
+		pointSetInfo = PointPartition::PointSetInfo< Real , Dim >( fs );
+		pointPartition = PointPartition::Partition( fs );
+		if( !fs.read( cumulativePointWeight ) ) ERROR_OUT( "Failed to read cumulative point weight" );
+		if( !fs.read( sharedVertexCounts ) ) ERROR_OUT( "Failed to read shared vertex counts" );
+		fclose( fp );
+	}
+	return true;
+}
+
+template< typename Real , unsigned int Dim >
+void Checkpoint< Real , Dim >::write( std::string tempDir , std::string header ) const
+{
+	// Write to temporary files and rename so that an interrupted write never invalidates the previous checkpoint
+	auto Commit = []( std::string tempFileName , std::string fileName )
+	{
+		try{ std::filesystem::rename( tempFileName , fileName ); }
+		catch( ... ){ ERROR_OUT( "Failed to rename: " , tempFileName , " -> " , fileName ); }
+	};
+	std::string stateFile = StateFile( tempDir , header ) , manifestFile = ManifestFile( tempDir , header );
+	{
+		FILE *fp = fopen( ( stateFile + std::string( ".tmp" ) ).c_str() , "wb" );
+		if( !fp ) ERROR_OUT( "Failed to open checkpoint state for writing: " , stateFile );
+		FileStream fs( fp );
+		pointSetInfo.write( fs );
+		pointPartition.write( fs );
+		fs.write( cumulativePointWeight );
+		fs.write( sharedVertexCounts );
+		fclose( fp );
+	}
+	Commit( stateFile + std::string( ".tmp" ) , stateFile );
+	{
+		std::ofstream fs( manifestFile + std::string( ".tmp" ) );
+		if( !fs.is_open() ) ERROR_OUT( "Failed to open manifest for writing: " , manifestFile );
+		fs << "clients " << clientCount << std::endl;
+		fs << "phase " << phase << std::endl;
+	}
+	Commit( manifestFile + std::string( ".tmp" ) , manifestFile );
+}
+
+template< typename Real , unsigned int Dim >
+void Checkpoint< Real , Dim >::advance( std::string tempDir , std::string header , unsigned int phase )
+{
+	using ShareType = typename ClientReconstructionInfo< Real , Dim >::ShareType;
+	unsigned int oldPhase = this->phase;
+	this->phase = phase;
+	write( tempDir , header );
+
+	// Restarting at phase p>1 requires the client state from phase p-2 and the server data from phase p-1
+	if( oldPhase>1 && oldPhase<=7 )
+	{
+		ClientReconstructionInfo< Real , Dim > clientReconInfo;
+		clientReconInfo.tempDir = tempDir;
+		clientReconInfo.header = header;
+		for( unsigned int i=0 ; i<clientCount ; i++ )
+		{
+			std::remove( clientReconInfo.clientCheckpointFile( i , oldPhase-2 ).c_str() );
+			std::remove( clientReconInfo.serverCheckpointFile( i , oldPhase-1 , ShareType::BACK   ).c_str() );
+			std::remove( clientReconInfo.serverCheckpointFile( i , oldPhase-1 , ShareType::CENTER ).c_str() );
+			std::remove( clientReconInfo.serverCheckpointFile( i , oldPhase-1 , ShareType::FRONT  ).c_str() );
+		}
+	}
+}
+
+template< typename Real , unsigned int Dim >
+void Checkpoint< Real , Dim >::Remove( std::string tempDir , std::string header )
+{
+	std::remove( ManifestFile( tempDir , header ).c_str() );
+	std::remove( StateFile( tempDir , header ).c_str() );
+}
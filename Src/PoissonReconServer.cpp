@@ -81,6 +81,9 @@ cmdLineParameter< int >
 	FilesPerDir( "filesPerDir" , -1 ) ,
 	MaxMemoryGB( "maxMemory" , 0 ) ,
 	PeakMemorySampleMS( "sampleMS" , 10 ) ,
+	SocketBufferSize( "socketBuffer" , 0 ) ,
+	SocketBatchSize( "socketBatch" , (int)SocketOptions().batchSize ) ,
+	PartitionMemoryMB( "partitionMemory" , 0 ) ,
 #ifdef _OPENMP
 	ParallelType( "parallel" , (int)ThreadPool::OPEN_MP ) ,
 #else // !_OPENMP
@@ -98,7 +101,13 @@ cmdLineReadable
 	LinearFit( "linearFit" ) ,
 	OutputVoxelGrid( "grid" ) ,
 	OutputBoundarySlices( "boundary" ) ,
-	ShowDiscontinuity( "showDiscontinuity" );
+	ShowDiscontinuity( "showDiscontinuity" ) ,
+	SaveCheckpoints( "checkpoint" ) ,
+	Resume( "resume" ) ,
+	DirectMerge( "directMerge" ) ,
+	AsyncReceive( "asyncReceive" ) ,
+	DirectIO( "directIO" ) ,
+	CacheStatistics( "cacheStats" );
 
 cmdLineParameter< float >
 	Scale( "scale" , 1.1f ) ,
@@ -133,6 +142,11 @@ cmdLineReadable* params[] =
 	&OutputVoxelGrid ,
 	&OutputBoundarySlices ,
 	&ShowDiscontinuity ,
+	&SaveCheckpoints , &Resume ,
+	&DirectMerge ,
+	&SocketBufferSize , &SocketBatchSize , &AsyncReceive ,
+	&PartitionMemoryMB , &DirectIO ,
+	&CacheStatistics ,
 	NULL
 };
 
@@ -188,6 +202,15 @@ void ShowUsage( char* ex )
 	printf( "\t[--%s]\n" , OutputVoxelGrid.name );
 	printf( "\t[--%s]\n" , OutputBoundarySlices.name );
 	printf( "\t[--%s]\n" , ShowDiscontinuity.name );
+	printf( "\t[--%s]\n" , SaveCheckpoints.name );
+	printf( "\t[--%s]\n" , Resume.name );
+	printf( "\t[--%s]\n" , DirectMerge.name );
+	printf( "\t[--%s <socket send/receive buffer size (in bytes)>=%d]\n" , SocketBufferSize.name , SocketBufferSize.value );
+	printf( "\t[--%s <socket write batch size (in bytes)>=%d]\n" , SocketBatchSize.name , SocketBatchSize.value );
+	printf( "\t[--%s]\n" , AsyncReceive.name );
+	printf( "\t[--%s <memory budget for partitioning (in MB)>=%d]\n" , PartitionMemoryMB.name , PartitionMemoryMB.value );
+	printf( "\t[--%s]\n" , DirectIO.name );
+	printf( "\t[--%s]\n" , CacheStatistics.name );
 
 	printf( "\t[--%s]\n" , Performance.name );
 }
@@ -204,7 +227,7 @@ Partition
 {
 	Timer timer;
 
-	std::pair< PointPartition::PointSetInfo< Real , Dim > , PointPartition::Partition > pointSetInfoAndPartition = PointPartitionClientServer::RunServer< Real , Dim >( clientSockets , clientPartitionInfo , loadBalance );
+	std::pair< PointPartition::PointSetInfo< Real , Dim > , PointPartition::Partition > pointSetInfoAndPartition = PointPartitionClientServer::RunServer< Real , Dim >( clientSockets , clientPartitionInfo , loadBalance , CacheStatistics.set );
 	unsigned int peakMem = 0;
 	for( unsigned int c=0 ; c<clientSockets.size() ; c++ )
 	{
@@ -231,7 +254,8 @@ Reconstruct
 	const PointPartition::PointSetInfo< Real , Dim > &pointSetInfo ,
 	const PointPartition::Partition &pointPartition ,
 	std::vector< Socket > &clientSockets ,
-	const PoissonReconClientServer::ClientReconstructionInfo< Real , Dim > &clientReconInfo
+	const PoissonReconClientServer::ClientReconstructionInfo< Real , Dim > &clientReconInfo ,
+	PoissonReconClientServer::Checkpoint< Real , Dim > *checkpoint
 )
 {
 	Timer timer;
@@ -239,7 +263,7 @@ Reconstruct
 	// Clean up files if they were not propertly cleaned up before.
 	for( unsigned int i=0 ; i<clientSockets.size() ; i++ ) PoissonReconClientServer::ClientServerStream< false >::Reset( i , clientReconInfo );
 
-	std::vector< unsigned int > sharedVertexCounts = PoissonReconClientServer::RunServer< Real , Dim , BType , Degree >( pointSetInfo , pointPartition , clientSockets , clientReconInfo , BaseVCycles.value , PeakMemorySampleMS.value<0 ? 0 : PeakMemorySampleMS.value , ShowDiscontinuity.set , OutputBoundarySlices.set );
+	std::vector< unsigned int > sharedVertexCounts = PoissonReconClientServer::RunServer< Real , Dim , BType , Degree >( pointSetInfo , pointPartition , clientSockets , clientReconInfo , BaseVCycles.value , PeakMemorySampleMS.value<0 ? 0 : PeakMemorySampleMS.value , ShowDiscontinuity.set , OutputBoundarySlices.set , checkpoint );
 
 	unsigned int peakMem = 0;
 	for( unsigned int i=0 ; i<clientSockets.size() ; i++ )
@@ -265,19 +289,19 @@ Reconstruct
 #ifdef FAST_COMPILE
 #else // !FAST_COMPILE
 template< typename Real , unsigned int Dim , BoundaryType BType >
-std::vector< unsigned int > Reconstruct( unsigned int degree , const PointPartition::PointSetInfo< Real , Dim > &pointSetInfo , const PointPartition::Partition &partition , std::vector< Socket > clientSockets , const PoissonReconClientServer::ClientReconstructionInfo< Real , Dim > &clientReconInfo )
+std::vector< unsigned int > Reconstruct( unsigned int degree , const PointPartition::PointSetInfo< Real , Dim > &pointSetInfo , const PointPartition::Partition &partition , std::vector< Socket > clientSockets , const PoissonReconClientServer::ClientReconstructionInfo< Real , Dim > &clientReconInfo , PoissonReconClientServer::Checkpoint< Real , Dim > *checkpoint )
 {
 	switch( degree )
 	{
-		case 1: return Reconstruct< Real , Dim , BType , 1 >( pointSetInfo , partition , clientSockets , clientReconInfo );
-		case 2: return Reconstruct< Real , Dim , BType , 2 >( pointSetInfo , partition , clientSockets , clientReconInfo );
+		case 1: return Reconstruct< Real , Dim , BType , 1 >( pointSetInfo , partition , clientSockets , clientReconInfo , checkpoint );
+		case 2: return Reconstruct< Real , Dim , BType , 2 >( pointSetInfo , partition , clientSockets , clientReconInfo , checkpoint );
 		default: ERROR_OUT( "Only B-Splines of degree 1 - 2 are supported" );
 	}
 	return std::vector< unsigned int >();
 }
 
 template< typename Real , unsigned int Dim >
-std::vector< unsigned int > Reconstruct( BoundaryType bType , unsigned int degree , const PointPartition::PointSetInfo< Real , Dim > &pointSetInfo , const PointPartition::Partition &partition , std::vector< Socket > clientSockets , const PoissonReconClientServer::ClientReconstructionInfo< Real , Dim > &clientReconInfo )
+std::vector< unsigned int > Reconstruct( BoundaryType bType , unsigned int degree , const PointPartition::PointSetInfo< Real , Dim > &pointSetInfo , const PointPartition::Partition &partition , std::vector< Socket > clientSockets , const PoissonReconClientServer::ClientReconstructionInfo< Real , Dim > &clientReconInfo , PoissonReconClientServer::Checkpoint< Real , Dim > *checkpoint )
 {
 	for( unsigned int i=0 ; i<clientSockets.size() ; i++ )
 	{
@@ -286,9 +310,9 @@ std::vector< unsigned int > Reconstruct( BoundaryType bType , unsigned int degre
 	}
 	switch( bType )
 	{
-		case BOUNDARY_FREE:      return Reconstruct< Real , Dim , BOUNDARY_FREE      >( degree , pointSetInfo , partition , clientSockets , clientReconInfo );
-		case BOUNDARY_NEUMANN:   return Reconstruct< Real , Dim , BOUNDARY_NEUMANN   >( degree , pointSetInfo , partition , clientSockets , clientReconInfo );
-		case BOUNDARY_DIRICHLET: return Reconstruct< Real , Dim , BOUNDARY_DIRICHLET >( degree , pointSetInfo , partition , clientSockets , clientReconInfo );
+		case BOUNDARY_FREE:      return Reconstruct< Real , Dim , BOUNDARY_FREE      >( degree , pointSetInfo , partition , clientSockets , clientReconInfo , checkpoint );
+		case BOUNDARY_NEUMANN:   return Reconstruct< Real , Dim , BOUNDARY_NEUMANN   >( degree , pointSetInfo , partition , clientSockets , clientReconInfo , checkpoint );
+		case BOUNDARY_DIRICHLET: return Reconstruct< Real , Dim , BOUNDARY_DIRICHLET >( degree , pointSetInfo , partition , clientSockets , clientReconInfo , checkpoint );
 		default: ERROR_OUT( "Not a valid boundary type: " , bType );
 	}
 	return std::vector< unsigned int >();
@@ -346,6 +370,8 @@ int main( int argc , char* argv[] )
 		return 0;
 	}
 	if( PadSize.value<0 ) ERROR_OUT( "Padding size cannot be negative" );
+	// The temporary file names are derived from the port, so they are only stable across runs if the port is
+	if( ( SaveCheckpoints.set || Resume.set ) && !Port.set ) ERROR_OUT( "Checkpointing requires the port to be specified" );
 
 	if( Verbose.value>1 )
 	{
@@ -372,6 +398,9 @@ int main( int argc , char* argv[] )
 	ThreadPool::DefaultChunkSize = ThreadChunkSize.value;
 	ThreadPool::DefaultSchedule = (ThreadPool::ScheduleType)ScheduleType.value;
 	ThreadPool::Init( (ThreadPool::ParallelType)ParallelType.value , Threads.value );
+	DefaultSocketOptions().bufferSize = SocketBufferSize.value;
+	DefaultSocketOptions().batchSize = (size_t)std::max< int >( SocketBatchSize.value , 0 );
+	DefaultSocketOptions().asyncReceive = AsyncReceive.set;
 	if( !Threads.set && Verbose.value>1 ) std::cout << "Running with " << Threads.value << " threads" << std::endl;
 	std::string header;
 
@@ -403,10 +432,30 @@ int main( int argc , char* argv[] )
 	}
 	std::vector< unsigned int > sharedVertexCounts;
 
+	PoissonReconClientServer::Checkpoint< Real , Dim > *checkpoint = NULL;
+	if( SaveCheckpoints.set || Resume.set )
+	{
+		checkpoint = new PoissonReconClientServer::Checkpoint< Real , Dim >();
+		if( Resume.set && checkpoint->read( TempDir.value , header ) )
+		{
+			if( checkpoint->clientCount!=(unsigned int)ClientCount.value ) ERROR_OUT( "Client count does not match checkpoint: " , ClientCount.value , " != " , checkpoint->clientCount );
+			if( Verbose.value>0 ) std::cout << "Resuming from checkpoint: " << PoissonReconClientServer::Checkpoint< Real , Dim >::ManifestFile( TempDir.value , header ) << " @ phase " << checkpoint->phase << std::endl;
+		}
+		else
+		{
+			if( Resume.set ) WARN( "No checkpoint found, starting from scratch" );
+			*checkpoint = PoissonReconClientServer::Checkpoint< Real , Dim >();
+			checkpoint->clientCount = ClientCount.value;
+		}
+	}
+	unsigned int resumePhase = checkpoint ? checkpoint->phase : 0;
+	for( unsigned int i=0 ; i<clientSockets.size() ; i++ ) SocketStream( clientSockets[i] ).write( resumePhase );
 
 	std::pair< PointPartition::PointSetInfo< Real , Dim > , PointPartition::Partition > pointSetInfoAndPartition;
 
 	// Get the partitioned points
+	if( resumePhase>=1 ) pointSetInfoAndPartition = std::make_pair( checkpoint->pointSetInfo , checkpoint->pointPartition );
+	else
 	{
 		PointPartition::CreatePointSlabDirs( PointPartition::FileDir( TempDir.value , header ) , 1<<PartitionDepth.value , FilesPerDir.value );
 		PointPartitionClientServer::ClientPartitionInfo< Real > clientPartitionInfo;
@@ -419,10 +468,20 @@ int main( int argc , char* argv[] )
 		clientPartitionInfo.bufferSize = BufferSize.value;
 		clientPartitionInfo.scale = Scale.value;
 		clientPartitionInfo.verbose = Verbose.value>1;
+		clientPartitionInfo.memoryMB = PartitionMemoryMB.value>0 ? (unsigned int)PartitionMemoryMB.value : 0;
+		clientPartitionInfo.directIO = DirectIO.set;
 		pointSetInfoAndPartition = Partition< Real , Dim >( clientSockets , clientPartitionInfo , !NoLoadBalance.set , Performance.set );
+		if( checkpoint )
+		{
+			checkpoint->pointSetInfo = pointSetInfoAndPartition.first;
+			checkpoint->pointPartition = pointSetInfoAndPartition.second;
+			checkpoint->advance( TempDir.value , header , 1 );
+		}
 	}
 
 	// Reconstruct the slabs
+	if( resumePhase>=8 ) sharedVertexCounts = checkpoint->sharedVertexCounts;
+	else
 	{
 		if( Width.value>0 )
 		{
@@ -492,10 +551,11 @@ int main( int argc , char* argv[] )
 			clientReconInfo.solveDepth = clientReconInfo.baseDepth;
 		}
 #ifdef FAST_COMPILE
-		sharedVertexCounts = Reconstruct< Real , Dim , Reconstructor::Poisson::DefaultFEMBoundary , Reconstructor::Poisson::DefaultFEMDegree >( pointSetInfoAndPartition.first , pointSetInfoAndPartition.second , clientSockets , clientReconInfo );
+		sharedVertexCounts = Reconstruct< Real , Dim , Reconstructor::Poisson::DefaultFEMBoundary , Reconstructor::Poisson::DefaultFEMDegree >( pointSetInfoAndPartition.first , pointSetInfoAndPartition.second , clientSockets , clientReconInfo , checkpoint );
 #else // !FAST_COMPILE
-		sharedVertexCounts = Reconstruct< Real , Dim >( (BoundaryType)BType.value , Degree.value , pointSetInfoAndPartition.first , pointSetInfoAndPartition.second , clientSockets , clientReconInfo );
+		sharedVertexCounts = Reconstruct< Real , Dim >( (BoundaryType)BType.value , Degree.value , pointSetInfoAndPartition.first , pointSetInfoAndPartition.second , clientSockets , clientReconInfo , checkpoint );
 #endif // FAST_COMPILE
+		if( checkpoint ) checkpoint->advance( TempDir.value , header , 8 );
 	}
 
 	if( Verbose.value>1 && ( MergeSlabs.value==MergeSlabType::SEAMLESS || MergeSlabs.value==MergeSlabType::TOPOLOGY_AND_FUNCTION ) ) 
@@ -515,6 +575,7 @@ int main( int argc , char* argv[] )
 		else clientMergePlyInfo.auxProperties = pointSetInfoAndPartition.first.auxiliaryProperties;
 		clientMergePlyInfo.bufferSize = BufferSize.value;
 		clientMergePlyInfo.verbose = Verbose.value!=0;
+		clientMergePlyInfo.direct = DirectMerge.set;
 		Merge< Real , Dim >( sharedVertexCounts , header , clientSockets , clientMergePlyInfo );
 
 		auto InFile = [&]( unsigned int idx )
@@ -531,6 +592,12 @@ int main( int argc , char* argv[] )
 		}
 	}
 
+	if( checkpoint )
+	{
+		PoissonReconClientServer::Checkpoint< Real , Dim >::Remove( TempDir.value , header );
+		delete checkpoint;
+	}
+
 	for( unsigned int i=0 ; i<clientSockets.size() ; i++ ) CloseSocket( clientSockets[i] );
 
 	ThreadPool::Terminate();
@@ -186,6 +186,8 @@ namespace Reconstructor
 			bool outputDensity;
 			bool exactInterpolation;
 			bool showResidual;
+			bool pipelinedCG;
+			bool directBaseSolve;
 			Real scale;
 			Real confidence;
 			Real confidenceBias;
@@ -194,6 +196,9 @@ namespace Reconstructor
 			Real pointWeight;
 			Real samplesPerNode;
 			Real cgSolverAccuracy;
+			Real sweepAccuracy;
+			Real sweepStagnation;
+			Real vCycleAccuracy;
 			unsigned int depth;
 			unsigned int solveDepth;
 			unsigned int baseDepth;
@@ -201,14 +206,16 @@ namespace Reconstructor
 			unsigned int kernelDepth;
 			unsigned int envelopeDepth;
 			unsigned int baseVCycles;
+			unsigned int vCycles;
 			unsigned int iters;
+			unsigned int cgPreconditioner;
 
 			SolutionParameters( void ) :
-				verbose(false) , dirichletErode(false) , outputDensity(false) , exactInterpolation(false) , showResidual(false) ,
+				verbose(false) , dirichletErode(false) , outputDensity(false) , exactInterpolation(false) , showResidual(false) , pipelinedCG(false) , directBaseSolve(false) ,
 				scale((Real)1.1) , confidence((Real)0.) , confidenceBias((Real)0.) , lowDepthCutOff((Real)0.) , width((Real)0.) ,
-				pointWeight((Real)0.) , samplesPerNode((Real)1.5) , cgSolverAccuracy((Real)1e-3 ) ,
+				pointWeight((Real)0.) , samplesPerNode((Real)1.5) , cgSolverAccuracy((Real)1e-3 ) , sweepAccuracy((Real)0.) , sweepStagnation((Real)0.) , vCycleAccuracy((Real)0.) ,
 				depth((unsigned int)8) , solveDepth((unsigned int)-1) , baseDepth((unsigned int)-1) , fullDepth((unsigned int)5) , kernelDepth((unsigned int)-1) ,
-				envelopeDepth((unsigned int)-1) , baseVCycles((unsigned int)1) , iters((unsigned int)8)
+				envelopeDepth((unsigned int)-1) , baseVCycles((unsigned int)1) , vCycles((unsigned int)1) , iters((unsigned int)8) , cgPreconditioner((unsigned int)CG_PRECONDITIONER_NONE)
 			{}
 		};
 
@@ -355,6 +362,8 @@ namespace Reconstructor
 			bool outputDensity;
 			bool exactInterpolation;
 			bool showResidual;
+			bool pipelinedCG;
+			bool directBaseSolve;
 			Real scale;
 			Real confidence;
 			Real confidenceBias;
@@ -365,20 +374,25 @@ namespace Reconstructor
 			Real biLapWeight;
 			Real samplesPerNode;
 			Real cgSolverAccuracy;
+			Real sweepAccuracy;
+			Real sweepStagnation;
+			Real vCycleAccuracy;
 			unsigned int depth;
 			unsigned int solveDepth;
 			unsigned int baseDepth;
 			unsigned int fullDepth;
 			unsigned int kernelDepth;
 			unsigned int baseVCycles;
+			unsigned int vCycles;
 			unsigned int iters;
+			unsigned int cgPreconditioner;
 
 			SolutionParameters( void ) :
-				verbose(false) , outputDensity(false) , exactInterpolation(false) , showResidual(false) ,
+				verbose(false) , outputDensity(false) , exactInterpolation(false) , showResidual(false) , pipelinedCG(false) , directBaseSolve(false) ,
 				scale((Real)1.1) , confidence((Real)0.) , confidenceBias((Real)0.) , lowDepthCutOff((Real)0.) , width((Real)0.) ,
-				pointWeight((Real)WeightMultipliers[0]) , gradientWeight((Real)WeightMultipliers[1]) , biLapWeight((Real)WeightMultipliers[2]) , samplesPerNode((Real)1.5) , cgSolverAccuracy((Real)1e-3 ) ,
+				pointWeight((Real)WeightMultipliers[0]) , gradientWeight((Real)WeightMultipliers[1]) , biLapWeight((Real)WeightMultipliers[2]) , samplesPerNode((Real)1.5) , cgSolverAccuracy((Real)1e-3 ) , sweepAccuracy((Real)0.) , sweepStagnation((Real)0.) , vCycleAccuracy((Real)0.) ,
 				depth((unsigned int)8) , solveDepth((unsigned int)-1) , baseDepth((unsigned int)-1) , fullDepth((unsigned int)5) , kernelDepth((unsigned int)-1) ,
-				baseVCycles((unsigned int)1) , iters((unsigned int)8)
+				baseVCycles((unsigned int)1) , vCycles((unsigned int)1) , iters((unsigned int)8) , cgPreconditioner((unsigned int)CG_PRECONDITIONER_NONE)
 			{}
 
 		};
@@ -895,7 +909,7 @@ namespace Reconstructor
 			{
 				profiler.reset();
 				typename FEMTree< Dim , Real >::SolverInfo _sInfo;
-				_sInfo.cgDepth = 0 , _sInfo.cascadic = true , _sInfo.vCycles = 1 , _sInfo.iters = params.iters , _sInfo.cgAccuracy = params.cgSolverAccuracy , _sInfo.verbose = params.verbose , _sInfo.showResidual = params.showResidual , _sInfo.showGlobalResidual = SHOW_GLOBAL_RESIDUAL_NONE , _sInfo.sliceBlockSize = 1;
+				_sInfo.cgDepth = 0 , _sInfo.cascadic = true , _sInfo.vCycles = params.vCycles , _sInfo.iters = params.iters , _sInfo.cgAccuracy = params.cgSolverAccuracy , _sInfo.sweepAccuracy = params.sweepAccuracy , _sInfo.sweepStagnation = params.sweepStagnation , _sInfo.vCycleAccuracy = params.vCycleAccuracy , _sInfo.pipelinedCG = params.pipelinedCG , _sInfo.cgPreconditioner = params.cgPreconditioner , _sInfo.directBaseSolve = params.directBaseSolve , _sInfo.verbose = params.verbose , _sInfo.showResidual = params.showResidual , _sInfo.showGlobalResidual = SHOW_GLOBAL_RESIDUAL_NONE , _sInfo.sliceBlockSize = 1;
 				_sInfo.baseVCycles = params.baseVCycles;
 				typename FEMIntegrator::template System< Sigs , IsotropicUIntPack< Dim , 1 > > F( { 0. , 1. } );
 				implicit.solution = implicit.tree.solveSystem( Sigs() , F , constraints , params.baseDepth , params.solveDepth , _sInfo , std::make_tuple( iInfo ) );
@@ -1200,7 +1214,7 @@ namespace Reconstructor
 			{
 				profiler.reset();
 				typename FEMTree< Dim , Real >::SolverInfo _sInfo;
-				_sInfo.cgDepth = 0 , _sInfo.cascadic = true , _sInfo.vCycles = 1 , _sInfo.iters = params.iters , _sInfo.cgAccuracy = params.cgSolverAccuracy , _sInfo.verbose = params.verbose , _sInfo.showResidual = params.showResidual , _sInfo.showGlobalResidual = SHOW_GLOBAL_RESIDUAL_NONE , _sInfo.sliceBlockSize = 1;
+				_sInfo.cgDepth = 0 , _sInfo.cascadic = true , _sInfo.vCycles = params.vCycles , _sInfo.iters = params.iters , _sInfo.cgAccuracy = params.cgSolverAccuracy , _sInfo.sweepAccuracy = params.sweepAccuracy , _sInfo.sweepStagnation = params.sweepStagnation , _sInfo.vCycleAccuracy = params.vCycleAccuracy , _sInfo.pipelinedCG = params.pipelinedCG , _sInfo.cgPreconditioner = params.cgPreconditioner , _sInfo.directBaseSolve = params.directBaseSolve , _sInfo.verbose = params.verbose , _sInfo.showResidual = params.showResidual , _sInfo.showGlobalResidual = SHOW_GLOBAL_RESIDUAL_NONE , _sInfo.sliceBlockSize = 1;
 				_sInfo.baseVCycles = params.baseVCycles;
 				typename FEMIntegrator::template System< Sigs , IsotropicUIntPack< Dim , 2 > > F( { 0. , 0. , (double)params.biLapWeight } );
 				implicit.solution = implicit.tree.solveSystem( Sigs() , F , constraints , params.baseDepth , params.solveDepth , _sInfo , std::make_tuple( iInfo ) );
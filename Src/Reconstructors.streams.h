@@ -532,9 +532,12 @@ protected:
 	std::vector< OutputDataStream< Vertex > * > _outStreams;
 };
 
-template< typename Real , unsigned int Dim , bool HasGradients , bool HasDensity >
+// When Compact is set, positions are quantized and gradients are octahedrally encoded
+template< typename Real , unsigned int Dim , bool HasGradients , bool HasDensity , bool Compact=false >
 struct OutputVertexInfo
 {
+	using PositionFactory = typename std::conditional< Compact , VertexFactory::QuantizedPositionFactory< Real , Dim > , VertexFactory::PositionFactory< Real , Dim > >::type;
+	using NormalFactory = typename std::conditional< Compact , VertexFactory::OctahedralNormalFactory< Real > , VertexFactory::NormalFactory< Real , Dim > >::type;
 	using Factory =
 		typename std::conditional
 		<
@@ -542,19 +545,31 @@ struct OutputVertexInfo
 			typename std::conditional
 			<
 				HasDensity ,
-				VertexFactory::Factory< Real , VertexFactory::PositionFactory< Real , Dim > , VertexFactory::NormalFactory< Real , Dim > , VertexFactory::ValueFactory< Real > > ,
-				VertexFactory::Factory< Real , VertexFactory::PositionFactory< Real , Dim > , VertexFactory::NormalFactory< Real , Dim > >
+				VertexFactory::Factory< Real , PositionFactory , NormalFactory , VertexFactory::ValueFactory< Real > > ,
+				VertexFactory::Factory< Real , PositionFactory , NormalFactory >
 			>::type ,
 			typename std::conditional
 			<
 				HasDensity ,
-				VertexFactory::Factory< Real , VertexFactory::PositionFactory< Real , Dim > , VertexFactory::ValueFactory< Real > > ,
-				VertexFactory::PositionFactory< Real , Dim >
+				VertexFactory::Factory< Real , PositionFactory , VertexFactory::ValueFactory< Real > > ,
+				PositionFactory
 			>::type
 		>::type;
 	using Vertex = typename Factory::VertexType;
 
-	static Factory GetFactory( void ){ return Factory(); }
+	static Factory GetFactory( PositionFactory positionFactory=PositionFactory() )
+	{
+		if constexpr( HasGradients )
+		{
+			if constexpr( HasDensity ) return Factory( positionFactory , NormalFactory() , VertexFactory::ValueFactory< Real >() );
+			else                       return Factory( positionFactory , NormalFactory() );
+		}
+		else
+		{
+			if constexpr( HasDensity ) return Factory( positionFactory , VertexFactory::ValueFactory< Real >() );
+			else                       return positionFactory;
+		}
+	}
 
 	struct StreamWrapper : public Reconstructor::OutputVertexStreamWrapper< Real , Dim , Vertex >
 	{
@@ -580,9 +595,12 @@ struct OutputVertexInfo
 	};
 };
 
-template< typename Real , unsigned int Dim , typename AuxDataFactory , bool HasGradients , bool HasDensity >
+// When Compact is set, positions are quantized and gradients are octahedrally encoded
+template< typename Real , unsigned int Dim , typename AuxDataFactory , bool HasGradients , bool HasDensity , bool Compact=false >
 struct OutputVertexWithDataInfo
 {
+	using PositionFactory = typename std::conditional< Compact , VertexFactory::QuantizedPositionFactory< Real , Dim > , VertexFactory::PositionFactory< Real , Dim > >::type;
+	using NormalFactory = typename std::conditional< Compact , VertexFactory::OctahedralNormalFactory< Real > , VertexFactory::NormalFactory< Real , Dim > >::type;
 	using Factory =
 		typename std::conditional
 		<
@@ -590,14 +608,14 @@ struct OutputVertexWithDataInfo
 			typename std::conditional
 			<
 				HasDensity ,
-				VertexFactory::Factory< Real , VertexFactory::PositionFactory< Real , Dim > , VertexFactory::NormalFactory< Real , Dim > , VertexFactory::ValueFactory< Real > , AuxDataFactory > ,
-				VertexFactory::Factory< Real , VertexFactory::PositionFactory< Real , Dim > , VertexFactory::NormalFactory< Real , Dim > , AuxDataFactory >
+				VertexFactory::Factory< Real , PositionFactory , NormalFactory , VertexFactory::ValueFactory< Real > , AuxDataFactory > ,
+				VertexFactory::Factory< Real , PositionFactory , NormalFactory , AuxDataFactory >
 			>::type ,
 			typename std::conditional
 			<
 				HasDensity ,
-				VertexFactory::Factory< Real , VertexFactory::PositionFactory< Real , Dim > , VertexFactory::ValueFactory< Real > , AuxDataFactory > ,
-				VertexFactory::Factory< Real , VertexFactory::PositionFactory< Real , Dim > , AuxDataFactory >
+				VertexFactory::Factory< Real , PositionFactory , VertexFactory::ValueFactory< Real > , AuxDataFactory > ,
+				VertexFactory::Factory< Real , PositionFactory , AuxDataFactory >
 			>::type
 		>::type;
 	using AuxData = typename AuxDataFactory::VertexType;
@@ -605,17 +623,17 @@ struct OutputVertexWithDataInfo
 	using _Vertex = VectorTypeUnion< Real , Point< Real , Dim > , Point< Real , Dim > , Real , typename AuxDataFactory::VertexType >;
 	using Vertex = typename Factory::VertexType;
 
-	static Factory GetFactory( AuxDataFactory auxDataFactory )
+	static Factory GetFactory( AuxDataFactory auxDataFactory , PositionFactory positionFactory=PositionFactory() )
 	{
 		if constexpr( HasGradients )
 		{
-			if constexpr( HasDensity ) return Factory( VertexFactory::PositionFactory< Real , Dim >() , VertexFactory::NormalFactory< Real , Dim >() , VertexFactory::ValueFactory< Real >() , auxDataFactory );
-			else                       return Factory( VertexFactory::PositionFactory< Real , Dim >() , VertexFactory::NormalFactory< Real , Dim >() ,                                         auxDataFactory );
+			if constexpr( HasDensity ) return Factory( positionFactory , NormalFactory() , VertexFactory::ValueFactory< Real >() , auxDataFactory );
+			else                       return Factory( positionFactory , NormalFactory() ,                                         auxDataFactory );
 		}
 		else
 		{
-			if constexpr( HasDensity ) return Factory( VertexFactory::PositionFactory< Real , Dim >() ,                                                VertexFactory::ValueFactory< Real >() , auxDataFactory );
-			else                       return Factory( VertexFactory::PositionFactory< Real , Dim >() ,                                                                                        auxDataFactory );
+			if constexpr( HasDensity ) return Factory( positionFactory ,                   VertexFactory::ValueFactory< Real >() , auxDataFactory );
+			else                       return Factory( positionFactory ,                                                           auxDataFactory );
 		}
 	}
 
@@ -56,6 +56,7 @@ cmdLineParameter< char* >
 cmdLineReadable
 	Performance( "performance" ) ,
 	ShowResidual( "showResidual" ) ,
+	DirectBaseSolve( "directBaseSolve" ) ,
 	PolygonMesh( "polygonMesh" ) ,
 	NonManifold( "nonManifold" ) ,
 	ASCII( "ascii" ) ,
@@ -76,12 +77,14 @@ cmdLineParameter< int >
 	KernelDepth( "kernelDepth" ) ,
 	SolveDepth( "solveDepth" ) ,
 	Iters( "iters" , 8 ) ,
+	VCycles( "vCycles" , 1 ) ,
 	FullDepth( "fullDepth" , 5 ) ,
 	BaseDepth( "baseDepth" ) ,
 	BaseVCycles( "baseVCycles" , 4 ) ,
 #ifndef FAST_COMPILE
 	BType( "bType" , Reconstructor::SSD::DefaultFEMBoundary+1 ) ,
 #endif // !FAST_COMPILE
+	CGPreconditionerType( "cgPreconditioner" , CG_PRECONDITIONER_NONE ) ,
 	MaxMemoryGB( "maxMemory" , 0 ) ,
 #ifdef _OPENMP
 	ParallelType( "parallel" , (int)ThreadPool::OPEN_MP ) ,
@@ -101,6 +104,9 @@ cmdLineParameter< float >
 	ConfidenceBias( "confidenceBias" , 0.f ) ,
 	LowDepthCutOff( "lowDepthCutOff" , 0.f ) ,
 	CGSolverAccuracy( "cgAccuracy" , 1e-3f ) ,
+	SweepAccuracy( "sweepAccuracy" , 0.f ) ,
+	SweepStagnation( "sweepStagnation" , 0.f ) ,
+	VCycleAccuracy( "vCycleAccuracy" , 0.f ) ,
 	ValueWeight   (    "valueWeight" , 1.f ) ,
 	GradientWeight( "gradientWeight" , 1.f ) ,
 	BiLapWeight   (    "biLapWeight" , 1.f );
@@ -114,7 +120,7 @@ cmdLineReadable* params[] =
 	&SolveDepth ,
 	&In , &Depth , &Out , &Transform ,
 	&Width ,
-	&Scale , &Verbose , &CGSolverAccuracy ,
+	&Scale , &Verbose , &CGSolverAccuracy , &CGPreconditionerType , &DirectBaseSolve ,
 	&KernelDepth , &SamplesPerNode , &Confidence , &NonManifold , &PolygonMesh , &ASCII , &ShowResidual ,
 	&ConfidenceBias ,
 	&ValueWeight , &GradientWeight , &BiLapWeight ,
@@ -123,7 +129,7 @@ cmdLineReadable* params[] =
 	&Density ,
 	&FullDepth ,
 	&BaseDepth , &BaseVCycles ,
-	&Iters ,
+	&Iters , &VCycles , &SweepAccuracy , &SweepStagnation , &VCycleAccuracy ,
 	&DataX ,
 	&Colors ,
 	&Gradients ,
@@ -165,6 +171,10 @@ void ShowUsage(char* ex)
 	printf( "\t[--%s <gradient weight>=%.3e]\n" , GradientWeight.name , GradientWeight.value );
 	printf( "\t[--%s <bi-laplacian weight>=%.3e]\n" , BiLapWeight.name , BiLapWeight.value );
 	printf( "\t[--%s <iterations>=%d]\n" , Iters.name , Iters.value );
+	printf( "\t[--%s <sweep residual reduction (0 = fixed iterations)>=%g]\n" , SweepAccuracy.name , SweepAccuracy.value );
+	printf( "\t[--%s <sweep stagnation ratio (0 = fixed iterations)>=%g]\n" , SweepStagnation.name , SweepStagnation.value );
+	printf( "\t[--%s <v-cycles>=%d]\n" , VCycles.name , VCycles.value );
+	printf( "\t[--%s <v-cycle relative residual (0 = fixed v-cycles)>=%g]\n" , VCycleAccuracy.name , VCycleAccuracy.value );
 	printf( "\t[--%s]\n" , ExactInterpolation.name );
 	printf( "\t[--%s <pull factor>=%f]\n" , DataX.name , DataX.value );
 	printf( "\t[--%s]\n" , Colors.name );
@@ -181,6 +191,9 @@ void ShowUsage(char* ex)
 	printf( "\t[--%s]\n" , NonManifold.name );
 	printf( "\t[--%s]\n" , PolygonMesh.name );
 	printf( "\t[--%s <cg solver accuracy>=%g]\n" , CGSolverAccuracy.name , CGSolverAccuracy.value );
+	printf( "\t[--%s <cg preconditioner>=%d]\n" , CGPreconditionerType.name , CGPreconditionerType.value );
+	for( int i=0 ; i<CG_PRECONDITIONER_COUNT ; i++ ) printf( "\t\t%d] %s\n" , i , CGPreconditionerNames[i] );
+	printf( "\t[--%s]\n" , DirectBaseSolve.name );
 	printf( "\t[--%s <maximum memory (in GB)>=%d]\n" , MaxMemoryGB.name , MaxMemoryGB.value );
 	printf( "\t[--%s]\n" , Performance.name );
 	printf( "\t[--%s]\n" , Density.name );
@@ -311,6 +324,7 @@ void Execute( const AuxDataFactory &auxDataFactory )
 	sParams.outputDensity = Density.set;
 	sParams.exactInterpolation = ExactInterpolation.set;
 	sParams.showResidual = ShowResidual.set;
+	sParams.directBaseSolve = DirectBaseSolve.set;
 	sParams.scale = (Real)Scale.value;
 	sParams.confidence = (Real)Confidence.value;
 	sParams.confidenceBias = (Real)ConfidenceBias.value;
@@ -321,6 +335,7 @@ void Execute( const AuxDataFactory &auxDataFactory )
 	sParams.biLapWeight = (Real)BiLapWeight.value;
 	sParams.samplesPerNode = (Real)SamplesPerNode.value;
 	sParams.cgSolverAccuracy = (Real)CGSolverAccuracy.value;
+	sParams.cgPreconditioner = (unsigned int)CGPreconditionerType.value;
 	sParams.depth = (unsigned int)Depth.value;
 	sParams.baseDepth = (unsigned int)BaseDepth.value;
 	sParams.solveDepth = (unsigned int)SolveDepth.value;
@@ -328,6 +343,10 @@ void Execute( const AuxDataFactory &auxDataFactory )
 	sParams.kernelDepth = (unsigned int)KernelDepth.value;
 	sParams.baseVCycles = (unsigned int)BaseVCycles.value;
 	sParams.iters = (unsigned int)Iters.value;
+	sParams.vCycles = (unsigned int)VCycles.value;
+	sParams.sweepAccuracy = (Real)SweepAccuracy.value;
+	sParams.sweepStagnation = (Real)SweepStagnation.value;
+	sParams.vCycleAccuracy = (Real)VCycleAccuracy.value;
 
 	meParams.linearFit = !NonLinearFit.set;
 	meParams.outputGradients = Gradients.set;
@@ -39,34 +39,73 @@ DAMAGE.
 #include <boost/asio.hpp>
 #include <stdarg.h>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <array>
 #include "Array.h"
 #include "MyMiscellany.h"
 #include "Streams.h"
 
 static const unsigned int SOCKET_CONNECT_WAIT = 500;		// Default time to wait on a socket (in ms)
 
-typedef boost::asio::ip::tcp::socket *Socket;
+struct SocketOptions
+{
+	bool noDelay;			// Disable Nagle's algorithm so that small messages are sent immediately
+	int bufferSize;			// If positive, the size (in bytes) of the kernel send/receive buffers
+	size_t batchSize;		// Writes are coalesced until this many bytes are pending (zero disables batching)
+	bool asyncReceive;		// Receive on a background thread into a buffer that reads are served from
+
+	SocketOptions( void ) : noDelay(true) , bufferSize(0) , batchSize(1<<12) , asyncReceive(false) {}
+};
+
+// The options used for newly connected/accepted sockets
+inline SocketOptions &DefaultSocketOptions( void ){ static SocketOptions options ; return options; }
+
+// A TCP socket that coalesces small writes and serves reads from a (read-ahead) buffer.
+// [NOTE] Pending writes are flushed when a stream on the socket is destroyed or flushed, and before blocking on any read,
+// so that a peer is never left waiting on data that is sitting in our buffer.
+class _Socket : public boost::asio::ip::tcp::socket
+{
+public:
+	_Socket( boost::asio::io_service &ios , const SocketOptions &options=DefaultSocketOptions() );
+	~_Socket( void );
+
+	// Applies the socket options and starts the background receiver (if requested) once the socket is connected
+	void start( void );
+
+	size_t send( const void *source , size_t len );
+	size_t receive( void *destination , size_t len );
+	void flush( void );
+
+	// Flushes the pending writes of all sockets
+	static void FlushAll( void );
+protected:
+	SocketOptions _options;
+	std::vector< unsigned char > _sendBuffer , _receiveBuffer;
+	size_t _receiveStart , _receiveEnd;
+	std::mutex _sendMutex;
+
+	std::thread _receiver;
+	std::mutex _receiveMutex;
+	std::condition_variable _receiveCondition;
+	bool _receiveClosed , _receiveStopping;
+
+	void _receiveLoop( void );
+	void _flush( void );
+
+	static std::mutex &_SocketsMutex( void ){ static std::mutex mutex ; return mutex; }
+	static std::vector< _Socket * > &_Sockets( void ){ static std::vector< _Socket * > sockets ; return sockets; }
+};
+
+typedef _Socket *Socket;
 typedef boost::asio::ip::tcp::acceptor *AcceptorSocket;
 typedef boost::asio::ip::address EndpointAddress;
 const Socket _INVALID_SOCKET_ = (Socket)NULL;
 const AcceptorSocket _INVALID_ACCEPTOR_SOCKET_ = (AcceptorSocket)NULL;
 static boost::asio::io_service io_service;
 
-template< class C > int socket_receive( Socket &s , C *destination , size_t len )
-{
-	boost::system::error_code ec;
-	int ret = (int)( boost::asio::read( *s , boost::asio::buffer( destination , len ) , ec ) );
-	if( ec ) ERROR_OUT( "Failed to read from socket" );
-	return ret;
-}
-
-template< class C > int socket_send( Socket& s , const C* source , size_t len )
-{
-	boost::system::error_code ec;
-	int ret = (int)( boost::asio::write( *s , boost::asio::buffer( source , len ) , ec ) );
-	if( ec ) ERROR_OUT( "Failed to write to socket" );
-	return ret;
-}
+template< class C > int socket_receive( Socket &s , C *destination , size_t len ){ return (int)s->receive( (void*)destination , len ); }
+template< class C > int socket_send( Socket& s , const C* source , size_t len ){ return (int)s->send( (const void*)source , len ); }
 
 inline bool AddressesEqual( const EndpointAddress& a1 ,  const EndpointAddress& a2 ){ return a1.to_string()==a2.to_string(); }
 inline const char *LastSocketError( void ){ return ""; }
@@ -140,6 +179,8 @@ void PrintHostAddress( void );
 struct SocketStream : public BinaryStream
 {
 	SocketStream( Socket socket=_INVALID_SOCKET_ ) : _socket(socket){}
+	~SocketStream( void ){ flush(); }
+	void flush( void ){ if( _socket ) _socket->flush(); }
 protected:
 	Socket _socket;
 	bool  _read(      Pointer( unsigned char ) ptr , size_t sz ){ return socket_receive( _socket , ptr , sizeof(unsigned char)*sz )==sz; }
@@ -26,6 +26,173 @@ ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF S
 DAMAGE.
 */
 
+/////////////
+// _Socket //
+/////////////
+inline _Socket::_Socket( boost::asio::io_service &ios , const SocketOptions &options )
+	: boost::asio::ip::tcp::socket( ios ) , _options(options) , _receiveStart(0) , _receiveEnd(0) , _receiveClosed(false) , _receiveStopping(false)
+{
+	std::lock_guard< std::mutex > lock( _SocketsMutex() );
+	_Sockets().push_back( this );
+}
+
+inline _Socket::~_Socket( void )
+{
+	flush();
+	{
+		std::lock_guard< std::mutex > lock( _SocketsMutex() );
+		std::vector< _Socket * > &sockets = _Sockets();
+		for( size_t i=0 ; i<sockets.size() ; i++ ) if( sockets[i]==this ){ sockets[i] = sockets.back() ; sockets.pop_back() ; break; }
+	}
+	if( _receiver.joinable() )
+	{
+		{
+			std::lock_guard< std::mutex > lock( _receiveMutex );
+			_receiveStopping = true;
+		}
+		_receiveCondition.notify_all();
+		boost::system::error_code ec;
+		shutdown( boost::asio::ip::tcp::socket::shutdown_both , ec );
+		_receiver.join();
+	}
+}
+
+inline void _Socket::start( void )
+{
+	boost::system::error_code ec;
+	set_option( boost::asio::ip::tcp::no_delay( _options.noDelay ) , ec );
+	if( ec ) WARN( "Failed to set TCP_NODELAY: " , ec.message() );
+	if( _options.bufferSize>0 )
+	{
+		set_option( boost::asio::socket_base::send_buffer_size( _options.bufferSize ) , ec );
+		if( ec ) WARN( "Failed to set send buffer size: " , ec.message() );
+		set_option( boost::asio::socket_base::receive_buffer_size( _options.bufferSize ) , ec );
+		if( ec ) WARN( "Failed to set receive buffer size: " , ec.message() );
+	}
+	_receiveBuffer.resize( std::max< size_t >( _options.batchSize , 1<<16 ) );
+	if( _options.asyncReceive ) _receiver = std::thread( [&]( void ){ _receiveLoop(); } );
+}
+
+inline void _Socket::_receiveLoop( void )
+{
+	std::vector< unsigned char > chunk( _receiveBuffer.size() );
+	while( true )
+	{
+		boost::system::error_code ec;
+		size_t sz = read_some( boost::asio::buffer( chunk ) , ec );
+
+		std::unique_lock< std::mutex > lock( _receiveMutex );
+		if( ec || _receiveStopping )
+		{
+			_receiveClosed = true;
+			_receiveCondition.notify_all();
+			return;
+		}
+		// Wait for the consumer to make room
+		while( _receiveEnd-_receiveStart+sz>_receiveBuffer.size() && !_receiveStopping ) _receiveCondition.wait( lock );
+		if( _receiveStopping ) return;
+		if( _receiveEnd+sz>_receiveBuffer.size() )
+		{
+			memmove( &_receiveBuffer[0] , &_receiveBuffer[_receiveStart] , _receiveEnd-_receiveStart );
+			_receiveEnd -= _receiveStart , _receiveStart = 0;
+		}
+		memcpy( &_receiveBuffer[_receiveEnd] , &chunk[0] , sz );
+		_receiveEnd += sz;
+		_receiveCondition.notify_all();
+	}
+}
+
+inline size_t _Socket::send( const void *source , size_t len )
+{
+	if( !len ) return 0;
+	std::lock_guard< std::mutex > lock( _sendMutex );
+	if( _sendBuffer.size()+len<=_options.batchSize )
+	{
+		const unsigned char *_source = (const unsigned char *)source;
+		_sendBuffer.insert( _sendBuffer.end() , _source , _source+len );
+		return len;
+	}
+
+	// Send the pending bytes together with the new ones
+	boost::system::error_code ec;
+	std::array< boost::asio::const_buffer , 2 > buffers = { boost::asio::buffer( _sendBuffer ) , boost::asio::buffer( source , len ) };
+	boost::asio::write( *this , buffers , ec );
+	if( ec ) ERROR_OUT( "Failed to write to socket: " , ec.message() );
+	_sendBuffer.clear();
+	return len;
+}
+
+inline void _Socket::flush( void )
+{
+	std::lock_guard< std::mutex > lock( _sendMutex );
+	_flush();
+}
+
+inline void _Socket::_flush( void )
+{
+	if( _sendBuffer.empty() ) return;
+	boost::system::error_code ec;
+	boost::asio::write( *this , boost::asio::buffer( _sendBuffer ) , ec );
+	if( ec ) ERROR_OUT( "Failed to write to socket: " , ec.message() );
+	_sendBuffer.clear();
+}
+
+inline void _Socket::FlushAll( void )
+{
+	std::lock_guard< std::mutex > lock( _SocketsMutex() );
+	std::vector< _Socket * > &sockets = _Sockets();
+	// [NOTE] A socket whose send lock is held is being written to by another thread, which will flush it before it blocks on a read
+	for( size_t i=0 ; i<sockets.size() ; i++ ) if( sockets[i]->_sendMutex.try_lock() )
+	{
+		std::lock_guard< std::mutex > lock( sockets[i]->_sendMutex , std::adopt_lock );
+		sockets[i]->_flush();
+	}
+}
+
+inline size_t _Socket::receive( void *destination , size_t len )
+{
+	unsigned char *_destination = (unsigned char *)destination;
+	FlushAll();
+
+	if( _receiver.joinable() )
+	{
+		size_t rec = 0;
+		std::unique_lock< std::mutex > lock( _receiveMutex );
+		while( rec<len )
+		{
+			while( _receiveStart==_receiveEnd && !_receiveClosed ) _receiveCondition.wait( lock );
+			if( _receiveStart==_receiveEnd ) ERROR_OUT( "Failed to read from socket" );
+			size_t sz = std::min< size_t >( len-rec , _receiveEnd-_receiveStart );
+			memcpy( _destination+rec , &_receiveBuffer[_receiveStart] , sz );
+			_receiveStart += sz , rec += sz;
+			if( _receiveStart==_receiveEnd ) _receiveStart = _receiveEnd = 0;
+			_receiveCondition.notify_all();
+		}
+		return len;
+	}
+
+	// Serve what we can from the read-ahead buffer
+	size_t rec = std::min< size_t >( len , _receiveEnd-_receiveStart );
+	if( rec ) memcpy( _destination , &_receiveBuffer[_receiveStart] , rec ) , _receiveStart += rec;
+	if( rec==len ) return len;
+
+	boost::system::error_code ec;
+	if( len-rec>=_receiveBuffer.size() ) boost::asio::read( *this , boost::asio::buffer( _destination+rec , len-rec ) , ec );
+	else
+	{
+		// Read (at least) the remainder into the buffer, picking up whatever else has already arrived
+		_receiveStart = 0;
+		_receiveEnd = boost::asio::read( *this , boost::asio::buffer( _receiveBuffer ) , boost::asio::transfer_at_least( len-rec ) , ec );
+		if( !ec )
+		{
+			memcpy( _destination+rec , &_receiveBuffer[0] , len-rec );
+			_receiveStart = len-rec;
+		}
+	}
+	if( ec ) ERROR_OUT( "Failed to read from socket: " , ec.message() );
+	return len;
+}
+
 template<class C>
 bool ReceiveOnSocket( Socket& s , Pointer( C ) data , size_t dataSize )
 {
@@ -175,7 +342,7 @@ inline Socket GetConnectSocket( const char* address , int port , int ms , bool p
 	boost::asio::ip::tcp::resolver resolver( io_service );
 	boost::asio::ip::tcp::resolver::query query( address , _port );
 	boost::asio::ip::tcp::resolver::iterator iterator = resolver.resolve( query );
-	Socket s = new boost::asio::ip::tcp::socket( io_service );
+	Socket s = new _Socket( io_service );
 	boost::system::error_code ec;
 	long long sleepCount = 0;
 	do
@@ -187,6 +354,7 @@ inline Socket GetConnectSocket( const char* address , int port , int ms , bool p
 	}
 	while( ec );
 	if( progress ) printf( "\n" ) , fflush( stdout );
+	s->start();
 	return s;
 }
 
@@ -197,7 +365,7 @@ inline Socket GetConnectSocket( EndpointAddress address , int port , int ms , bo
 	boost::asio::ip::tcp::resolver resolver( io_service );
 	boost::asio::ip::tcp::resolver::query query( address.to_string().c_str() , _port );
 	boost::asio::ip::tcp::resolver::iterator iterator = resolver.resolve( query );
-	Socket s = new boost::asio::ip::tcp::socket( io_service );
+	Socket s = new _Socket( io_service );
 	boost::system::error_code ec;
 	long long sleepCount = 0;
 	do
@@ -209,13 +377,15 @@ inline Socket GetConnectSocket( EndpointAddress address , int port , int ms , bo
 	}
 	while( ec );
 	if( progress ) std::cout << std::endl;
+	s->start();
 	return s;
 }
 
 inline Socket AcceptSocket( AcceptorSocket listen )
 {
-	Socket s = new boost::asio::ip::tcp::socket( io_service );
+	Socket s = new _Socket( io_service );
 	listen->accept( *s );
+	s->start();
 	return s;
 }
 
@@ -30,6 +30,8 @@ DAMAGE.
 #define SPARSE_MATRIX_INTERFACE_INCLUDED
 
 #define FORCE_TWO_BYTE_ALIGNMENT 1
+#include <cmath>
+#include <algorithm>
 #include "MyMiscellany.h"
 #include "Array.h"
 
@@ -83,6 +85,8 @@ public:
 	template< class T2 > void gsIteration( const              std::vector< size_t >  & multiColorIndices , ConstPointer( T ) diagonal , ConstPointer( T2 ) b , Pointer( T2 ) x ,                bool dReciprocal ) const;
 	template< class T2 > void gsIteration( const std::vector< std::vector< size_t > >& multiColorIndices , ConstPointer( T ) diagonal , ConstPointer( T2 ) b , Pointer( T2 ) x , bool forward , bool dReciprocal ) const;
 	template< class T2 > void gsIteration( ConstPointer( T ) diagonal , ConstPointer( T2 ) b , Pointer( T2 ) x , bool forward , bool dReciprocal ) const;
+	// Performs a multi-colored Gauss-Seidel sweep and returns the square norm of the residual obtained as a by-product of the sweep (each row's residual just before the row is relaxed)
+	template< class T2 , class TDotT > double gsIteration( const std::vector< std::vector< size_t > >& multiColorIndices , ConstPointer( T ) diagonal , ConstPointer( T2 ) b , Pointer( T2 ) x , bool forward , bool dReciprocal , TDotT Dot ) const;
 };
 
 // Assuming that the SPDOperator class defines:
@@ -90,6 +94,79 @@ public:
 template< class SPDFunctor , class T , typename Real , class TDotTFunctor > size_t SolveCG( const SPDFunctor& M , size_t dim , ConstPointer( T ) b , size_t iters , Pointer( T ) x , double eps , TDotTFunctor Dot );
 template< class SPDFunctor , class Preconditioner , class T , typename Real , class TDotTFunctor > size_t SolveCG( const SPDFunctor& M , const Preconditioner& P , size_t dim , ConstPointer( T ) b , size_t iters , Pointer( T ) x , double eps , TDotTFunctor Dot );
 
+// Conjugate-gradients for the operator x -> M * x [+ average(x) * 1], with M a symmetric (semi-)definite sparse matrix
+// Each iteration makes two parallel passes: a matrix multiply fused with the dot-products consuming its output, and a pass fusing all the vector updates with the reductions that follow.
+// If pipelined is set, the Ghysels-Vanroose formulation is used, in which none of an iteration's reductions depend on that iteration's multiply.
+template< class T , typename Real , class SPDMatrix , class TDotTFunctor > size_t SolveFusedCG( const SPDMatrix &M , bool addDCTerm , size_t dim , ConstPointer( T ) b , size_t iters , Pointer( T ) x , double eps , TDotTFunctor Dot , bool pipelined=false );
+
+enum
+{
+	CG_PRECONDITIONER_NONE ,
+	CG_PRECONDITIONER_DIAGONAL ,
+	CG_PRECONDITIONER_SYMMETRIC_GAUSS_SEIDEL ,
+	CG_PRECONDITIONER_BLOCK_JACOBI ,
+	CG_PRECONDITIONER_INCOMPLETE_CHOLESKY ,
+	CG_PRECONDITIONER_COUNT
+};
+const char* CGPreconditionerNames[] = { "none" , "diagonal" , "symmetric Gauss-Seidel" , "block Jacobi" , "incomplete Cholesky" };
+
+// A symmetric, positive-definite approximation of the inverse of the symmetric, positive-definite sparse matrix M:
+// -- CG_PRECONDITIONER_DIAGONAL: The inverse of the diagonal
+// -- CG_PRECONDITIONER_SYMMETRIC_GAUSS_SEIDEL: A forward and a backward Gauss-Seidel sweep, parallelized over the colors of multiColorIndices if given
+// -- CG_PRECONDITIONER_BLOCK_JACOBI: A symmetric Gauss-Seidel sweep within each of the blocks of consecutive rows starting at blockStarts, ignoring the coupling between blocks, in parallel over the blocks
+// -- CG_PRECONDITIONER_INCOMPLETE_CHOLESKY: The zero fill-in incomplete Cholesky factorization of (the lower triangle of) M
+template< typename Real , class SPDMatrix >
+class CGPreconditioner
+{
+public:
+	CGPreconditioner( const SPDMatrix &M , int type , const std::vector< std::vector< size_t > > *multiColorIndices=NULL , const std::vector< size_t > *blockStarts=NULL );
+	~CGPreconditioner( void );
+	int type( void ) const { return _type; }
+	// The preconditioner is diagonal, so that it can be applied one entry at a time
+	bool isDiagonal( void ) const { return _type==CG_PRECONDITIONER_DIAGONAL; }
+	template< class T > T operator()( size_t i , T r ) const { return (T)( r * _dR[i] ); }
+	template< class T > void operator()( ConstPointer( T ) r , Pointer( T ) u ) const;
+protected:
+	const SPDMatrix &_M;
+	int _type;
+	Pointer( Real ) _dR;
+	const std::vector< std::vector< size_t > > *_multiColorIndices;
+	std::vector< size_t > _blockStarts;
+	// The rows of the incomplete Cholesky factor, with the diagonal entry last
+	std::vector< size_t > _lStarts;
+	std::vector< std::pair< size_t , Real > > _lEntries;
+
+	template< class T > void _blockSweep( size_t begin , size_t end , ConstPointer( T ) r , Pointer( T ) u , bool forward ) const;
+};
+
+// A direct solver for symmetric, positive-definite sparse matrices, storing the Cholesky factor over the envelope (profile) of the lower triangle, so that the factor can be computed once and re-used across solves.
+// If addDCTerm is set, the matrix is assumed to be singular with the constants spanning the kernel, and the solver solves the system for the operator x -> M * x + average(x) * 1 (as does the CG solver) by pinning the value at the last row.
+class EnvelopeCholesky
+{
+public:
+	EnvelopeCholesky( void ) : _addDCTerm(false){}
+	// The number of floating-point operations in the factorization, which can be used to decide if it is worth computing
+	template< class SPDMatrix > static double FactorCost( const SPDMatrix &M );
+	// Returns false if the factorization breaks down
+	template< class SPDMatrix > bool factor( const SPDMatrix &M , bool addDCTerm );
+	template< class T > void solve( ConstPointer( T ) b , Pointer( T ) x ) const;
+	size_t rows( void ) const { return _first.size(); }
+	size_t entries( void ) const { return _values.size(); }
+protected:
+	bool _addDCTerm;
+	// The first column of each row of the factor, and the offset of the row in the values
+	std::vector< size_t > _first , _starts;
+	std::vector< double > _values;
+	// Empty rows are left out of the system, with the corresponding solution entries set to zero
+	std::vector< char > _empty;
+
+	template< class SPDMatrix > static size_t _FirstColumn( const SPDMatrix &M , size_t i );
+};
+
+// Preconditioned conjugate-gradients for the operator x -> M * x [+ average(x) * 1], with M a symmetric (semi-)definite sparse matrix, fusing the passes as in the un-preconditioned solver
+// Convergence is measured with the (un-preconditioned) residual so that the accuracy does not depend on the choice of preconditioner.
+template< class T , typename Real , class SPDMatrix , class TDotTFunctor > size_t SolveFusedCG( const SPDMatrix &M , const CGPreconditioner< Real , SPDMatrix > &P , bool addDCTerm , size_t dim , ConstPointer( T ) b , size_t iters , Pointer( T ) x , double eps , TDotTFunctor Dot );
+
 template< typename T >
 struct AbstractArrayWrapper
 {
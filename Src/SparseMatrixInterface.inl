@@ -260,6 +260,31 @@ void SparseMatrixInterface< T , const_iterator >::gsIteration( const std::vector
 #undef ITERATE
 	}
 }
+template< class T , class const_iterator >
+template< class T2 , class TDotT >
+double SparseMatrixInterface< T , const_iterator >::gsIteration( const std::vector< std::vector< size_t > >& multiColorIndices , ConstPointer( T ) diagonal , ConstPointer( T2 ) b , Pointer( T2 ) x , bool forward , bool dReciprocal , TDotT Dot ) const
+{
+	std::vector< double > rNorms( ThreadPool::NumThreads() , 0 );
+	auto Iterate = [&]( const std::vector< size_t > &indices )
+	{
+		ThreadPool::Parallel_for( 0 , indices.size() , [&]( unsigned int thread , size_t k )
+		{
+			size_t jj = indices[k];
+			T2 _b = b[jj];
+			const_iterator e = end( jj );
+			for( const_iterator iter = begin( jj ) ; iter!=e ; iter++ ) _b -= x[iter->N] * iter->Value;
+			rNorms[thread] += Dot( _b , _b );
+			if( dReciprocal ) x[jj] += _b * diagonal[jj];
+			else              x[jj] += _b / diagonal[jj];
+		}
+		);
+	};
+	if( forward ) for( size_t j=0 ; j<multiColorIndices.size() ; j++ ) Iterate( multiColorIndices[j] );
+	else for( long long j=(long long)multiColorIndices.size()-1 ; j>=0 ; j-- ) Iterate( multiColorIndices[j] );
+	double rNorm = 0;
+	for( unsigned int t=0 ; t<ThreadPool::NumThreads() ; t++ ) rNorm += rNorms[t];
+	return rNorm;
+}
 template< class SPDFunctor , class T , typename Real , class TDotTFunctor > size_t SolveCG( const SPDFunctor& M , size_t dim , ConstPointer( T ) b , size_t iters , Pointer( T ) x , double eps , TDotTFunctor Dot )
 {
 	std::vector< Real > scratch( ThreadPool::NumThreads() , 0 );
@@ -297,7 +322,7 @@ template< class SPDFunctor , class T , typename Real , class TDotTFunctor > size
 		{
 			ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int , size_t i ){ x[i] += (T)( d[i] * alpha ); } );
 			M( ( ConstPointer( T ) )x , r );
-			ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int thread , size_t i ){ r[i] = b[i] - r[i] , scratch[thread] += Dot( r[i] , r[i] ) , x[i] += (T)( d[i] * alpha ); } );
+			ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int thread , size_t i ){ r[i] = b[i] - r[i] , scratch[thread] += Dot( r[i] , r[i] ); } );
 			for( unsigned int t=0 ; t<ThreadPool::NumThreads() ; t++ ){ delta_new += scratch[t] ; scratch[t] = 0; }
 		}
 		else
@@ -362,13 +387,13 @@ template< class SPDFunctor , class Preconditioner , class T , typename Real , cl
 		{
 			ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int , size_t i ){ x[i] += (T)( d[i] * alpha ); } );
 			PM( ( ConstPointer( T ) )x , r );
-			ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int thread , size_t i ){ r[i] = Pb[i] - r[i] , scratch[thread] += Dot( r[i] , r[i] ) , x[i] += (T)( d[i] * alpha ); } );
-			for( unsigned int t=0 ; t<ThreadPool::NumThreads() ; t++ ) delta_new += scratch[t];
+			ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int thread , size_t i ){ r[i] = Pb[i] - r[i] , scratch[thread] += Dot( r[i] , r[i] ); } );
+			for( unsigned int t=0 ; t<ThreadPool::NumThreads() ; t++ ){ delta_new += scratch[t] ; scratch[t] = 0; }
 		}
 		else
 		{
 			ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int thread , size_t i ){ r[i] -=(T)( q[i] * alpha ) , scratch[thread] += Dot( r[i] , r[i] ) ,  x[i] += (T)( d[i] * alpha ); } );
-			for( unsigned int t=0 ; t<ThreadPool::NumThreads() ; t++ ) delta_new += scratch[t];
+			for( unsigned int t=0 ; t<ThreadPool::NumThreads() ; t++ ){ delta_new += scratch[t] ; scratch[t] = 0; }
 		}
 
 		Real beta = delta_new / delta_old;
@@ -381,3 +406,523 @@ template< class SPDFunctor , class Preconditioner , class T , typename Real , cl
 	FreePointer( temp );
 	return ii;
 }
+
+// Per-thread partial sums, each on its own cache line so that the threads do not false-share
+template< typename V >
+struct _PaddedThreadSums
+{
+	_PaddedThreadSums( void ) : _sums( ThreadPool::NumThreads() ){ for( size_t t=0 ; t<_sums.size() ; t++ ) _sums[t].value = {}; }
+	V &operator[]( unsigned int thread ){ return _sums[thread].value; }
+	// Returns the total and clears the partial sums
+	V reduce( void )
+	{
+		V sum = {};
+		for( size_t t=0 ; t<_sums.size() ; t++ ) sum += _sums[t].value , _sums[t].value = {};
+		return sum;
+	}
+protected:
+	struct alignas( 64 ) _Sum{ V value; };
+	std::vector< _Sum > _sums;
+};
+
+// Sets out = M * in + shift, calling f( thread , i ) as soon as out[i] is set
+template< class T , class SPDMatrix , class RowFunction >
+void _FusedMultiply( const SPDMatrix &M , ConstPointer( T ) in , Pointer( T ) out , T shift , RowFunction f )
+{
+	ThreadPool::Parallel_for( 0 , M.rows() , [&]( unsigned int thread , size_t i )
+	{
+		T temp = {};
+		auto e = M.end( i );
+		for( auto iter=M.begin( i ) ; iter!=e ; iter++ ) temp += (T)( in[ iter->N ] * iter->Value );
+		out[i] = temp + shift;
+		f( thread , i );
+	}
+	);
+}
+
+// The operator x -> M * x [+ average(x) * 1] and the reductions shared by the fused conjugate-gradient solvers
+template< class T , typename Real , class SPDMatrix , class TDotTFunctor >
+struct _FusedCGOperator
+{
+	_PaddedThreadSums< double > dot1 , dot2;
+	// The partial sums of the vector the next multiply is applied to, needed for the DC term
+	_PaddedThreadSums< T > sum;
+
+	_FusedCGOperator( const SPDMatrix &M , bool addDCTerm , size_t dim , TDotTFunctor Dot ) : _M(M) , _addDCTerm(addDCTerm) , _dim(dim) , _Dot(Dot){}
+
+	void accumulate( unsigned int thread , const T &v ){ if( _addDCTerm ) sum[thread] += v; }
+
+	// Sets out = M * in [+ average(in)], with the average taken from the accumulated sums, calling f( thread , i ) as soon as out[i] is set
+	template< class RowFunction >
+	void multiply( ConstPointer( T ) in , Pointer( T ) out , RowFunction f )
+	{
+		T shift = sum.reduce();
+		if( _addDCTerm ) shift /= (Real)_dim;
+		else shift = {};
+		_FusedMultiply( _M , in , out , shift , f );
+	}
+
+	// Sets out = M * in [+ average(in)]
+	void multiply( ConstPointer( T ) in , Pointer( T ) out )
+	{
+		sum.reduce();
+		if( _addDCTerm ) ThreadPool::Parallel_for( 0 , _dim , [&]( unsigned int thread , size_t i ){ sum[thread] += in[i]; } );
+		multiply( in , out , []( unsigned int , size_t ){} );
+	}
+
+	// Sets r = b - M * x [- average(x)], optionally accumulating the partial sums of r, and returns r.r
+	double residual( ConstPointer( T ) b , ConstPointer( T ) x , Pointer( T ) r , bool accumulateR )
+	{
+		multiply( x , r );
+		ThreadPool::Parallel_for( 0 , _dim , [&]( unsigned int thread , size_t i )
+		{
+			r[i] = b[i] - r[i];
+			dot1[thread] += _Dot( r[i] , r[i] );
+			if( accumulateR ) accumulate( thread , r[i] );
+		}
+		);
+		return dot1.reduce();
+	}
+protected:
+	const SPDMatrix &_M;
+	bool _addDCTerm;
+	size_t _dim;
+	TDotTFunctor _Dot;
+};
+
+template< class T , typename Real , class SPDMatrix , class TDotTFunctor > size_t SolveFusedCG( const SPDMatrix &M , bool addDCTerm , size_t dim , ConstPointer( T ) b , size_t iters , Pointer( T ) x , double eps , TDotTFunctor Dot , bool pipelined )
+{
+	eps *= eps;
+	_FusedCGOperator< T , Real , SPDMatrix , TDotTFunctor > op( M , addDCTerm , dim , Dot );
+
+	size_t ii;
+	double gamma_old = 0 , alpha_old = 0;
+	if( !pipelined )
+	{
+		// Chronopoulos-Gear: s = M * r is multiplied out and q = M * d is updated recursively, so the dot-products d.q and r.r come from the multiply and the update passes
+		Pointer( T ) r = AllocPointer< T >( dim );
+		Pointer( T ) d = AllocPointer< T >( dim );
+		Pointer( T ) q = AllocPointer< T >( dim );
+		Pointer( T ) s = AllocPointer< T >( dim );
+
+		double gamma = op.residual( b , ( ConstPointer( T ) )x , r , true ) , delta_0 = gamma;
+		if( gamma<=eps )
+		{
+			FreePointer( r );
+			FreePointer( d );
+			FreePointer( q );
+			FreePointer( s );
+			return 0;
+		}
+		memset( d , 0 , sizeof(T)*dim );
+		memset( q , 0 , sizeof(T)*dim );
+
+		for( ii=0 ; ii<iters && gamma>eps*delta_0 ; ii++ )
+		{
+			op.multiply( ( ConstPointer( T ) )r , s , [&]( unsigned int thread , size_t i ){ op.dot1[thread] += Dot( r[i] , s[i] ); } );
+			double delta = op.dot1.reduce();
+			double beta = ii ? gamma / gamma_old : 0;
+			double dDotQ = ii ? delta - beta * gamma / alpha_old : delta;
+			if( !dDotQ ) break;
+
+			Real alpha = (Real)( gamma / dDotQ ) , _beta = (Real)beta;
+			ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int thread , size_t i )
+			{
+				d[i] = r[i] + (T)( d[i] * _beta ) , q[i] = s[i] + (T)( q[i] * _beta );
+				x[i] += (T)( d[i] * alpha ) , r[i] -= (T)( q[i] * alpha );
+				op.dot1[thread] += Dot( r[i] , r[i] );
+				op.accumulate( thread , r[i] );
+			}
+			);
+			gamma_old = gamma , alpha_old = alpha;
+			gamma = op.dot1.reduce();
+			// Replace the recursively updated vectors with the true ones
+			if( (ii%50)==(50-1) )
+			{
+				op.multiply( ( ConstPointer( T ) )d , q );
+				gamma = op.residual( b , ( ConstPointer( T ) )x , r , true );
+			}
+		}
+		FreePointer( r );
+		FreePointer( d );
+		FreePointer( q );
+		FreePointer( s );
+	}
+	else
+	{
+		// Ghysels-Vanroose: w = M * r , s = M * p , and z = M * s are updated recursively and q = M * w is multiplied out, so the dot-products r.r and w.r come from the multiply pass
+		Pointer( T ) r = AllocPointer< T >( dim );
+		Pointer( T ) w = AllocPointer< T >( dim );
+		Pointer( T ) q = AllocPointer< T >( dim );
+		Pointer( T ) z = AllocPointer< T >( dim );
+		Pointer( T ) s = AllocPointer< T >( dim );
+		Pointer( T ) p = AllocPointer< T >( dim );
+		auto SumW = [&]( unsigned int thread , size_t i ){ op.accumulate( thread , w[i] ); };
+
+		double delta_0 = op.residual( b , ( ConstPointer( T ) )x , r , true );
+		if( delta_0<=eps )
+		{
+			FreePointer( r );
+			FreePointer( w );
+			FreePointer( q );
+			FreePointer( z );
+			FreePointer( s );
+			FreePointer( p );
+			return 0;
+		}
+		op.multiply( ( ConstPointer( T ) )r , w , SumW );
+		memset( z , 0 , sizeof(T)*dim );
+		memset( s , 0 , sizeof(T)*dim );
+		memset( p , 0 , sizeof(T)*dim );
+
+		for( ii=0 ; ii<iters ; ii++ )
+		{
+			op.multiply( ( ConstPointer( T ) )w , q , [&]( unsigned int thread , size_t i ){ op.dot1[thread] += Dot( r[i] , r[i] ) , op.dot2[thread] += Dot( w[i] , r[i] ); } );
+			double gamma = op.dot1.reduce() , delta = op.dot2.reduce();
+			if( gamma<=eps*delta_0 ) break;
+			double beta = ii ? gamma / gamma_old : 0;
+			double dDotQ = ii ? delta - beta * gamma / alpha_old : delta;
+			if( !dDotQ ) break;
+
+			Real alpha = (Real)( gamma / dDotQ ) , _beta = (Real)beta;
+			ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int thread , size_t i )
+			{
+				z[i] = q[i] + (T)( z[i] * _beta ) , s[i] = w[i] + (T)( s[i] * _beta ) , p[i] = r[i] + (T)( p[i] * _beta );
+				x[i] += (T)( p[i] * alpha ) , r[i] -= (T)( s[i] * alpha ) , w[i] -= (T)( z[i] * alpha );
+				SumW( thread , i );
+			}
+			);
+			gamma_old = gamma , alpha_old = alpha;
+			// Replace the recursively updated vectors with the true ones
+			if( (ii%50)==(50-1) )
+			{
+				op.multiply( ( ConstPointer( T ) )p , s );
+				op.multiply( ( ConstPointer( T ) )s , z );
+				op.residual( b , ( ConstPointer( T ) )x , r , true );
+				op.multiply( ( ConstPointer( T ) )r , w , SumW );
+			}
+		}
+		FreePointer( r );
+		FreePointer( w );
+		FreePointer( q );
+		FreePointer( z );
+		FreePointer( s );
+		FreePointer( p );
+	}
+	return ii;
+}
+
+template< typename Real , class SPDMatrix >
+CGPreconditioner< Real , SPDMatrix >::CGPreconditioner( const SPDMatrix &M , int type , const std::vector< std::vector< size_t > > *multiColorIndices , const std::vector< size_t > *blockStarts ) : _M(M) , _type(type) , _dR( NullPointer( Real ) ) , _multiColorIndices(multiColorIndices)
+{
+	size_t dim = _M.rows();
+	switch( _type )
+	{
+		case CG_PRECONDITIONER_NONE: break;
+		case CG_PRECONDITIONER_DIAGONAL:
+		case CG_PRECONDITIONER_SYMMETRIC_GAUSS_SEIDEL:
+		case CG_PRECONDITIONER_BLOCK_JACOBI:
+			_dR = AllocPointer< Real >( dim );
+			_M.setDiagonalR( _dR );
+			if( _type==CG_PRECONDITIONER_BLOCK_JACOBI )
+			{
+				if( blockStarts ) _blockStarts = *blockStarts;
+				if( !_blockStarts.size() || _blockStarts[0] ) _blockStarts.insert( _blockStarts.begin() , 0 );
+				_blockStarts.push_back( dim );
+			}
+			break;
+		case CG_PRECONDITIONER_INCOMPLETE_CHOLESKY:
+		{
+			// Set the sparsity of the factor from the lower triangle of the matrix
+			_lStarts.resize( dim+1 );
+			_lStarts[0] = 0;
+			for( size_t i=0 ; i<dim ; i++ )
+			{
+				size_t count = 1;
+				for( auto iter=_M.begin( i ) ; iter!=_M.end( i ) ; iter++ ) if( (size_t)iter->N<i ) count++;
+				_lStarts[i+1] = _lStarts[i] + count;
+			}
+			_lEntries.resize( _lStarts[dim] );
+
+			// L_ik = ( a_ik - \sum_{j<k} L_ij * L_kj ) / L_kk , L_ii = sqrt( a_ii - \sum_{k<i} L_ik * L_ik )
+			std::vector< size_t > position( dim , -1 );
+			for( size_t i=0 ; i<dim ; i++ )
+			{
+				std::pair< size_t , Real > *row = &_lEntries[ _lStarts[i] ];
+				size_t count = 0;
+				Real a = 0;
+				for( auto iter=_M.begin( i ) ; iter!=_M.end( i ) ; iter++ )
+					if     ( (size_t)iter->N< i ) row[count++] = std::pair< size_t , Real >( iter->N , iter->Value );
+					else if( (size_t)iter->N==i ) a += iter->Value;
+				std::sort( row , row+count , []( const std::pair< size_t , Real > &e1 , const std::pair< size_t , Real > &e2 ){ return e1.first<e2.first; } );
+				for( size_t j=0 ; j<count ; j++ ) position[ row[j].first ] = j;
+
+				Real diagonal = a;
+				for( size_t j=0 ; j<count ; j++ )
+				{
+					size_t k = row[j].first;
+					const std::pair< size_t , Real > *_row = &_lEntries[ _lStarts[k] ];
+					size_t _count = _lStarts[k+1] - _lStarts[k] - 1;
+					for( size_t _j=0 ; _j<_count ; _j++ ) if( position[ _row[_j].first ]!=-1 ) row[j].second -= row[ position[ _row[_j].first ] ].second * _row[_j].second;
+					row[j].second /= _row[_count].second;
+					diagonal -= row[j].second * row[j].second;
+				}
+				// If the factorization breaks down, fall back on the diagonal
+				if( diagonal<=0 ) diagonal = a>0 ? a : (Real)1;
+				row[count] = std::pair< size_t , Real >( i , (Real)sqrt( diagonal ) );
+				for( size_t j=0 ; j<count ; j++ ) position[ row[j].first ] = -1;
+			}
+			break;
+		}
+		default: ERROR_OUT( "Unrecognized preconditioner: " , _type );
+	}
+}
+
+template< typename Real , class SPDMatrix >
+CGPreconditioner< Real , SPDMatrix >::~CGPreconditioner( void ){ FreePointer( _dR ); }
+
+template< typename Real , class SPDMatrix >
+template< class T >
+void CGPreconditioner< Real , SPDMatrix >::_blockSweep( size_t begin , size_t end , ConstPointer( T ) r , Pointer( T ) u , bool forward ) const
+{
+	auto Update = [&]( size_t j )
+	{
+		T _r = r[j];
+		auto e = _M.end( j );
+		for( auto iter=_M.begin( j ) ; iter!=e ; iter++ ) if( (size_t)iter->N>=begin && (size_t)iter->N<end ) _r -= u[iter->N] * iter->Value;
+		u[j] += _r * _dR[j];
+	};
+	if( forward ) for( size_t j=begin ; j<end ; j++ ) Update( j );
+	else          for( size_t j=end ; j>begin ; j-- ) Update( j-1 );
+}
+
+template< typename Real , class SPDMatrix >
+template< class T >
+void CGPreconditioner< Real , SPDMatrix >::operator()( ConstPointer( T ) r , Pointer( T ) u ) const
+{
+	size_t dim = _M.rows();
+	switch( _type )
+	{
+		case CG_PRECONDITIONER_NONE:
+			ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int , size_t i ){ u[i] = r[i]; } );
+			break;
+		case CG_PRECONDITIONER_DIAGONAL:
+			ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int , size_t i ){ u[i] = (T)( r[i] * _dR[i] ); } );
+			break;
+		case CG_PRECONDITIONER_SYMMETRIC_GAUSS_SEIDEL:
+			memset( u , 0 , sizeof(T)*dim );
+			if( _multiColorIndices )
+			{
+				_M.gsIteration( *_multiColorIndices , ( ConstPointer( Real ) )_dR , r , u , true , true );
+				_M.gsIteration( *_multiColorIndices , ( ConstPointer( Real ) )_dR , r , u , false , true );
+			}
+			else
+			{
+				_M.gsIteration( ( ConstPointer( Real ) )_dR , r , u , true , true );
+				_M.gsIteration( ( ConstPointer( Real ) )_dR , r , u , false , true );
+			}
+			break;
+		case CG_PRECONDITIONER_BLOCK_JACOBI:
+			memset( u , 0 , sizeof(T)*dim );
+			ThreadPool::Parallel_for( 0 , _blockStarts.size()-1 , [&]( unsigned int , size_t b )
+			{
+				_blockSweep( _blockStarts[b] , _blockStarts[b+1] , r , u , true );
+				_blockSweep( _blockStarts[b] , _blockStarts[b+1] , r , u , false );
+			}
+			);
+			break;
+		case CG_PRECONDITIONER_INCOMPLETE_CHOLESKY:
+			// Solve L * y = r and then L^t * u = y, with y stored in u
+			for( size_t i=0 ; i<dim ; i++ )
+			{
+				const std::pair< size_t , Real > *row = &_lEntries[ _lStarts[i] ];
+				size_t count = _lStarts[i+1] - _lStarts[i] - 1;
+				T y = r[i];
+				for( size_t j=0 ; j<count ; j++ ) y -= u[ row[j].first ] * row[j].second;
+				u[i] = y / row[count].second;
+			}
+			for( size_t i=dim ; i>0 ; i-- )
+			{
+				const std::pair< size_t , Real > *row = &_lEntries[ _lStarts[i-1] ];
+				size_t count = _lStarts[i] - _lStarts[i-1] - 1;
+				u[i-1] /= row[count].second;
+				for( size_t j=0 ; j<count ; j++ ) u[ row[j].first ] -= u[i-1] * row[j].second;
+			}
+			break;
+	}
+}
+
+template< class T , typename Real , class SPDMatrix , class TDotTFunctor > size_t SolveFusedCG( const SPDMatrix &M , const CGPreconditioner< Real , SPDMatrix > &P , bool addDCTerm , size_t dim , ConstPointer( T ) b , size_t iters , Pointer( T ) x , double eps , TDotTFunctor Dot )
+{
+	eps *= eps;
+	_FusedCGOperator< T , Real , SPDMatrix , TDotTFunctor > op( M , addDCTerm , dim , Dot );
+
+	// Chronopoulos-Gear: u = P * r is preconditioned, w = M * u is multiplied out, and s = M * p is updated recursively
+	Pointer( T ) r = AllocPointer< T >( dim );
+	Pointer( T ) u = AllocPointer< T >( dim );
+	Pointer( T ) w = AllocPointer< T >( dim );
+	Pointer( T ) p = AllocPointer< T >( dim );
+	Pointer( T ) s = AllocPointer< T >( dim );
+	auto Precondition = [&]( void )
+	{
+		P( ( ConstPointer( T ) )r , u );
+		if( addDCTerm ) ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int thread , size_t i ){ op.accumulate( thread , u[i] ); } );
+	};
+
+	double rr = op.residual( b , ( ConstPointer( T ) )x , r , false ) , delta_0 = rr;
+	if( rr<=eps )
+	{
+		FreePointer( r );
+		FreePointer( u );
+		FreePointer( w );
+		FreePointer( p );
+		FreePointer( s );
+		return 0;
+	}
+	Precondition();
+	memset( p , 0 , sizeof(T)*dim );
+	memset( s , 0 , sizeof(T)*dim );
+
+	size_t ii;
+	double gamma_old = 0 , alpha_old = 0;
+	for( ii=0 ; ii<iters && rr>eps*delta_0 ; ii++ )
+	{
+		op.multiply( ( ConstPointer( T ) )u , w , [&]( unsigned int thread , size_t i ){ op.dot1[thread] += Dot( r[i] , u[i] ) , op.dot2[thread] += Dot( w[i] , u[i] ); } );
+		double gamma = op.dot1.reduce() , delta = op.dot2.reduce();
+		double beta = ii ? gamma / gamma_old : 0;
+		double pDotS = ii ? delta - beta * gamma / alpha_old : delta;
+		if( !pDotS ) break;
+
+		Real alpha = (Real)( gamma / pDotS ) , _beta = (Real)beta;
+		bool diagonal = P.isDiagonal();
+		ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int thread , size_t i )
+		{
+			p[i] = u[i] + (T)( p[i] * _beta ) , s[i] = w[i] + (T)( s[i] * _beta );
+			x[i] += (T)( p[i] * alpha ) , r[i] -= (T)( s[i] * alpha );
+			op.dot1[thread] += Dot( r[i] , r[i] );
+			if( diagonal ) u[i] = P( i , r[i] ) , op.accumulate( thread , u[i] );
+		}
+		);
+		gamma_old = gamma , alpha_old = alpha;
+		rr = op.dot1.reduce();
+		// Replace the recursively updated vectors with the true ones
+		if( (ii%50)==(50-1) )
+		{
+			op.multiply( ( ConstPointer( T ) )p , s );
+			rr = op.residual( b , ( ConstPointer( T ) )x , r , false );
+			op.sum.reduce();
+			Precondition();
+		}
+		else if( !diagonal ) Precondition();
+	}
+	FreePointer( r );
+	FreePointer( u );
+	FreePointer( w );
+	FreePointer( p );
+	FreePointer( s );
+	return ii;
+}
+
+template< class SPDMatrix >
+size_t EnvelopeCholesky::_FirstColumn( const SPDMatrix &M , size_t i )
+{
+	size_t first = i;
+	for( auto iter=M.begin( i ) ; iter!=M.end( i ) ; iter++ ) if( iter->Value && (size_t)iter->N<first ) first = iter->N;
+	return first;
+}
+
+template< class SPDMatrix >
+double EnvelopeCholesky::FactorCost( const SPDMatrix &M )
+{
+	double cost = 0;
+	for( size_t i=0 ; i<M.rows() ; i++ )
+	{
+		double width = (double)( i - _FirstColumn( M , i ) );
+		cost += width * ( width + 1 ) / 2;
+	}
+	return cost;
+}
+
+template< class SPDMatrix >
+bool EnvelopeCholesky::factor( const SPDMatrix &M , bool addDCTerm )
+{
+	size_t dim = M.rows();
+	_addDCTerm = addDCTerm && dim;
+	size_t pinned = _addDCTerm ? dim-1 : (size_t)-1;
+	_first.resize( dim ) , _starts.resize( dim+1 ) , _empty.resize( dim );
+
+	_starts[0] = 0;
+	for( size_t i=0 ; i<dim ; i++ )
+	{
+		_empty[i] = M.rowSize( i )==0;
+		_first[i] = ( _empty[i] || i==pinned ) ? i : _FirstColumn( M , i );
+		_starts[i+1] = _starts[i] + ( i - _first[i] + 1 );
+	}
+	_values.resize( _starts[dim] );
+
+	// Copy the lower triangle, with the empty rows and the pinned row/column replaced by the identity
+	ThreadPool::Parallel_for( 0 , dim , [&]( unsigned int , size_t i )
+	{
+		double *row = &_values[ _starts[i] ] - _first[i];
+		for( size_t j=_first[i] ; j<=i ; j++ ) row[j] = 0;
+		if( _empty[i] || i==pinned ) row[i] = 1;
+		else for( auto iter=M.begin( i ) ; iter!=M.end( i ) ; iter++ ) if( (size_t)iter->N<=i && (size_t)iter->N!=pinned ) row[ iter->N ] += iter->Value;
+	}
+	);
+
+	// L_ij = ( a_ij - \sum_{k<j} L_ik * L_jk ) / L_jj , L_ii = sqrt( a_ii - \sum_{k<i} L_ik * L_ik )
+	for( size_t i=0 ; i<dim ; i++ )
+	{
+		double *row = &_values[ _starts[i] ] - _first[i];
+		double a = row[i];
+		for( size_t j=_first[i] ; j<i ; j++ )
+		{
+			const double *_row = &_values[ _starts[j] ] - _first[j];
+			double value = row[j];
+			for( size_t k=std::max< size_t >( _first[i] , _first[j] ) ; k<j ; k++ ) value -= row[k] * _row[k];
+			row[j] = value / _row[j];
+			row[i] -= row[j] * row[j];
+		}
+		// Fail if the pivot vanishes, relative to the diagonal entry it came from
+		// (The tolerance is loose enough to catch matrices that are only singular up to single-precision round-off.)
+		if( !( row[i]>a*1e-6 ) ) return false;
+		row[i] = sqrt( row[i] );
+	}
+	return true;
+}
+
+template< class T >
+void EnvelopeCholesky::solve( ConstPointer( T ) b , Pointer( T ) x ) const
+{
+	size_t dim = _first.size();
+	T sum = {} , average = {};
+	if( _addDCTerm )
+	{
+		for( size_t i=0 ; i<dim ; i++ ) sum += b[i];
+		average = sum , average /= (double)dim;
+	}
+	// Solve L * y = b and then L^t * x = y, with y stored in x
+	for( size_t i=0 ; i<dim ; i++ )
+	{
+		const double *row = &_values[ _starts[i] ] - _first[i];
+		if( _empty[i] || ( _addDCTerm && i==dim-1 ) ){ x[i] = T{} ; continue; }
+		T y = b[i];
+		if( _addDCTerm ) y -= average;
+		for( size_t j=_first[i] ; j<i ; j++ ) y -= x[j] * row[j];
+		x[i] = y / row[i];
+	}
+	for( size_t i=dim ; i>0 ; i-- )
+	{
+		const double *row = &_values[ _starts[i-1] ] - _first[i-1];
+		x[i-1] /= row[i-1];
+		for( size_t j=_first[i-1] ; j<i-1 ; j++ ) x[j] -= x[i-1] * row[j];
+	}
+	// Shift by the constant that makes the sum of the solution match the sum of the constraints
+	if( _addDCTerm )
+	{
+		T shift = sum;
+		for( size_t i=0 ; i<dim ; i++ ) shift -= x[i];
+		shift /= (double)dim;
+		for( size_t i=0 ; i<dim ; i++ ) x[i] += shift;
+	}
+}
@@ -256,6 +256,97 @@ namespace VertexFactory
 		static const std::string _PlyNames[];
 	};
 
+	// The quantized position factory
+	// Positions are stored as unsigned integers with the prescribed number of bits, relative to a cube given by its origin and size
+	template< typename Real , unsigned int Dim >
+	struct QuantizedPositionFactory : _Factory< Point< Real , Dim > , QuantizedPositionFactory< Real , Dim > >
+	{
+		typedef typename _Factory< Point< Real , Dim > , QuantizedPositionFactory< Real , Dim > >::VertexType VertexType;
+		typedef typename PositionFactory< Real , Dim >::Transform Transform;
+
+		VertexType operator()( void ) const { return VertexType(); }
+
+		unsigned int  plyReadNum( void ) const { return Dim; }
+		unsigned int plyWriteNum( void ) const { return Dim; }
+		bool plyValidReadProperties( const bool *flags ) const { for( int d=0 ; d<Dim ; d++ ) if( !flags[d] ) return false ; return true ; }
+		PlyProperty  plyReadProperty( unsigned int idx ) const;
+		PlyProperty plyWriteProperty( unsigned int idx ) const;
+		bool   readASCII( FILE *fp ,       VertexType &dt ) const;
+		void  writeASCII( FILE *fp , const VertexType &dt ) const;
+		bool  readBinary( FILE *fp ,       VertexType &dt ) const;
+		void writeBinary( FILE *fp , const VertexType &dt ) const;
+
+		bool isStaticallyAllocated( void ) const{ return false; }
+		PlyProperty  plyStaticReadProperty( unsigned int idx ) const { ERROR_OUT( "does not support static allocation" ) ; return PlyProperty(); }
+		PlyProperty plyStaticWriteProperty( unsigned int idx ) const { ERROR_OUT( "does not support static allocation" ) ; return PlyProperty(); }
+
+		QuantizedPositionFactory( Point< Real , Dim > origin , Real size , unsigned int bits );
+		// Quantizes relative to the bounding cube of the image of the unit cube
+		QuantizedPositionFactory( XForm< Real , Dim+1 > unitCubeToModel , unsigned int bits );
+
+		size_t bufferSize( void ) const { return _typeSize * Dim; }
+		void toBuffer( const VertexType &dt , Pointer( char ) buffer ) const;
+		void fromBuffer( ConstPointer( char ) buffer , VertexType &dt ) const;
+
+		Point< Real , Dim > origin( void ) const { return _origin; }
+		double step( void ) const { return _size / _steps(); }
+		// The largest distance between a position and its quantized representation
+		Real maxError( void ) const { return (Real)( step() * sqrt( (double)Dim ) / 2 ); }
+
+		bool operator == ( const QuantizedPositionFactory &factory ) const;
+	protected:
+		Point< Real , Dim > _origin;
+		Real _size;
+		unsigned int _bits;
+		int _plyType;
+		size_t _typeSize;
+		static const std::string _PlyNames[];
+
+		double _steps( void ) const { return (double)( ( ( (uint64_t)1 )<<_bits ) - 1 ); }
+		uint32_t _quantize( Real v , unsigned int d ) const;
+		Real _dequantize( uint32_t q , unsigned int d ) const { return (Real)( _origin[d] + q / _steps() * _size ); }
+	};
+
+	// The octahedral normal factory
+	// Unit normals are mapped to the octahedron and stored as two signed 16-bit integers (the magnitude is not preserved)
+	template< typename Real >
+	struct OctahedralNormalFactory : public _Factory< Point< Real , 3 > , OctahedralNormalFactory< Real > >
+	{
+		typedef typename _Factory< Point< Real , 3 > , OctahedralNormalFactory< Real > >::VertexType VertexType;
+		typedef typename NormalFactory< Real , 3 >::Transform Transform;
+
+		VertexType operator()( void ) const { return VertexType(); }
+
+		unsigned int  plyReadNum( void ) const { return 2; }
+		unsigned int plyWriteNum( void ) const { return 2; }
+		bool plyValidReadProperties( const bool *flags ) const { return flags[0] && flags[1]; }
+		PlyProperty  plyReadProperty( unsigned int idx ) const;
+		PlyProperty plyWriteProperty( unsigned int idx ) const;
+		bool   readASCII( FILE *fp ,       VertexType &dt ) const;
+		void  writeASCII( FILE *fp , const VertexType &dt ) const;
+		bool  readBinary( FILE *fp ,       VertexType &dt ) const;
+		void writeBinary( FILE *fp , const VertexType &dt ) const;
+
+		bool isStaticallyAllocated( void ) const{ return false; }
+		PlyProperty  plyStaticReadProperty( unsigned int idx ) const { ERROR_OUT( "does not support static allocation" ) ; return PlyProperty(); }
+		PlyProperty plyStaticWriteProperty( unsigned int idx ) const { ERROR_OUT( "does not support static allocation" ) ; return PlyProperty(); }
+
+		size_t bufferSize( void ) const { return sizeof( int16_t ) * 2; }
+		void toBuffer( const VertexType &dt , Pointer( char ) buffer ) const;
+		void fromBuffer( ConstPointer( char ) buffer , VertexType &dt ) const;
+
+		// A bound on the angle (in radians) between a normal and its quantized representation
+		static Real MaxAngularError( void ) { return (Real)( 3. / sqrt( 2. ) / _Steps ); }
+
+		bool operator == ( const OctahedralNormalFactory &factory ) const { return true; }
+	protected:
+		static const int16_t _Steps = 32767;
+		static const std::string _PlyNames[];
+
+		static void _Encode( const VertexType &n , int16_t q[2] );
+		static void _Decode( const int16_t q[2] , VertexType &n );
+	};
+
 	// The texture factory
 	template< typename Real , unsigned int Dim >
 	struct TextureFactory : public _Factory< Point< Real , Dim > , TextureFactory< Real , Dim > >
@@ -287,6 +287,233 @@ namespace VertexFactory
 	template<> const std::string NormalFactory<  float , 3 >::_PlyNames[] = { "nx" , "ny" , "nz" };
 	template<> const std::string NormalFactory< double , 3 >::_PlyNames[] = { "nx" , "ny" , "nz" };
 
+	//////////////////////////////
+	// QuantizedPositionFactory //
+	//////////////////////////////
+	template< typename Real , unsigned int Dim >
+	QuantizedPositionFactory< Real , Dim >::QuantizedPositionFactory( Point< Real , Dim > origin , Real size , unsigned int bits ) : _origin(origin) , _size(size) , _bits(bits)
+	{
+		if( !_bits || _bits>32 ) ERROR_OUT( "Quantization bits must be in [1,32]: " , _bits );
+		if( _size<=0 ) ERROR_OUT( "Quantization size must be positive: " , _size );
+		if( _bits<=16 ) _plyType = PLY_USHORT , _typeSize = sizeof( uint16_t );
+		else            _plyType = PLY_UINT   , _typeSize = sizeof( uint32_t );
+	}
+
+	template< typename Real , unsigned int Dim >
+	QuantizedPositionFactory< Real , Dim >::QuantizedPositionFactory( XForm< Real , Dim+1 > unitCubeToModel , unsigned int bits ) : QuantizedPositionFactory( Point< Real , Dim >() , (Real)1 , bits )
+	{
+		Point< Real , Dim > min , max;
+		for( unsigned int c=0 ; c<(1u<<Dim) ; c++ )
+		{
+			Point< Real , Dim > p;
+			for( unsigned int d=0 ; d<Dim ; d++ ) p[d] = (Real)( ( c>>d ) & 1 );
+			p = unitCubeToModel * p;
+			for( unsigned int d=0 ; d<Dim ; d++ )
+			{
+				if( !c || p[d]<min[d] ) min[d] = p[d];
+				if( !c || p[d]>max[d] ) max[d] = p[d];
+			}
+		}
+		_origin = min;
+		_size = 0;
+		for( unsigned int d=0 ; d<Dim ; d++ ) _size = std::max< Real >( _size , max[d]-min[d] );
+		if( _size<=0 ) ERROR_OUT( "Quantization size must be positive: " , _size );
+	}
+
+	template< typename Real , unsigned int Dim >
+	uint32_t QuantizedPositionFactory< Real , Dim >::_quantize( Real v , unsigned int d ) const
+	{
+		double s = ( (double)v - _origin[d] ) / _size * _steps();
+		return (uint32_t)( std::min< double >( std::max< double >( s , 0 ) , _steps() ) + 0.5 );
+	}
+
+	template< typename Real , unsigned int Dim >
+	void QuantizedPositionFactory< Real , Dim >::toBuffer( const VertexType &dt , Pointer( char ) buffer ) const
+	{
+		for( unsigned int d=0 ; d<Dim ; d++ )
+		{
+			uint32_t q = _quantize( dt[d] , d );
+			if( _typeSize==sizeof( uint16_t ) ){ uint16_t _q = (uint16_t)q ; memcpy( buffer + _typeSize*d , &_q , _typeSize ); }
+			else memcpy( buffer + _typeSize*d , &q , _typeSize );
+		}
+	}
+
+	template< typename Real , unsigned int Dim >
+	void QuantizedPositionFactory< Real , Dim >::fromBuffer( ConstPointer( char ) buffer , VertexType &dt ) const
+	{
+		for( unsigned int d=0 ; d<Dim ; d++ )
+		{
+			uint32_t q;
+			if( _typeSize==sizeof( uint16_t ) ){ uint16_t _q ; memcpy( &_q , buffer + _typeSize*d , _typeSize ) ; q = _q; }
+			else memcpy( &q , buffer + _typeSize*d , _typeSize );
+			dt[d] = _dequantize( q , d );
+		}
+	}
+
+	template< typename Real , unsigned int Dim >
+	bool QuantizedPositionFactory< Real , Dim >::readASCII( FILE *fp , VertexType &dt ) const
+	{
+		for( unsigned int d=0 ; d<Dim ; d++ )
+		{
+			unsigned int q;
+			if( fscanf( fp , " %u" , &q )!=1 ) return false;
+			dt[d] = _dequantize( q , d );
+		}
+		return true;
+	}
+
+	template< typename Real , unsigned int Dim >
+	void QuantizedPositionFactory< Real , Dim >::writeASCII( FILE *fp , const VertexType &dt ) const
+	{
+		for( unsigned int d=0 ; d<Dim ; d++ ) fprintf( fp , " %u" , (unsigned int)_quantize( dt[d] , d ) );
+	}
+
+	template< typename Real , unsigned int Dim >
+	bool QuantizedPositionFactory< Real , Dim >::readBinary( FILE *fp , VertexType &dt ) const
+	{
+		char buffer[ sizeof( uint32_t ) * Dim ];
+		if( fread( buffer , _typeSize , Dim , fp )!=Dim ) return false;
+		fromBuffer( buffer , dt );
+		return true;
+	}
+
+	template< typename Real , unsigned int Dim >
+	void QuantizedPositionFactory< Real , Dim >::writeBinary( FILE *fp , const VertexType &dt ) const
+	{
+		char buffer[ sizeof( uint32_t ) * Dim ];
+		toBuffer( dt , buffer );
+		fwrite( buffer , _typeSize , Dim , fp );
+	}
+
+	template< typename Real , unsigned int Dim >
+	PlyProperty QuantizedPositionFactory< Real , Dim >::plyReadProperty( unsigned int idx ) const
+	{
+		if( idx>= plyReadNum() ) ERROR_OUT( "read property out of bounds" );
+		return PlyProperty( _PlyNames[idx] , _plyType , _plyType , (int)( _typeSize*idx ) );
+	}
+	template< typename Real , unsigned int Dim >
+	PlyProperty QuantizedPositionFactory< Real , Dim >::plyWriteProperty( unsigned int idx ) const
+	{
+		if( idx>=plyWriteNum() ) ERROR_OUT( "write property out of bounds" );
+		return PlyProperty( _PlyNames[idx] , _plyType , _plyType , (int)( _typeSize*idx ) );
+	}
+
+	template< typename Real , unsigned int Dim >
+	bool QuantizedPositionFactory< Real , Dim >::operator == ( const QuantizedPositionFactory &factory ) const
+	{
+		if( _size!=factory._size || _bits!=factory._bits ) return false;
+		for( unsigned int d=0 ; d<Dim ; d++ ) if( _origin[d]!=factory._origin[d] ) return false;
+		return true;
+	}
+
+	template<> const std::string QuantizedPositionFactory<  float , 1 >::_PlyNames[] = { "x" };
+	template<> const std::string QuantizedPositionFactory< double , 1 >::_PlyNames[] = { "x" };
+	template<> const std::string QuantizedPositionFactory<  float , 2 >::_PlyNames[] = { "x" , "y" };
+	template<> const std::string QuantizedPositionFactory< double , 2 >::_PlyNames[] = { "x" , "y" };
+	template<> const std::string QuantizedPositionFactory<  float , 3 >::_PlyNames[] = { "x" , "y" , "z" };
+	template<> const std::string QuantizedPositionFactory< double , 3 >::_PlyNames[] = { "x" , "y" , "z" };
+
+	/////////////////////////////
+	// OctahedralNormalFactory //
+	/////////////////////////////
+	template< typename Real >
+	void OctahedralNormalFactory< Real >::_Encode( const VertexType &n , int16_t q[2] )
+	{
+		double l1 = fabs( (double)n[0] ) + fabs( (double)n[1] ) + fabs( (double)n[2] );
+		if( !l1 ){ q[0] = q[1] = 0 ; return; }
+		double u = n[0] / l1 , v = n[1] / l1;
+		if( n[2]<0 )
+		{
+			double _u = ( 1. - fabs(v) ) * ( u>=0 ? 1. : -1. );
+			double _v = ( 1. - fabs(u) ) * ( v>=0 ? 1. : -1. );
+			u = _u , v = _v;
+		}
+		q[0] = (int16_t)floor( std::min< double >( std::max< double >( u , -1. ) , 1. ) * _Steps + 0.5 );
+		q[1] = (int16_t)floor( std::min< double >( std::max< double >( v , -1. ) , 1. ) * _Steps + 0.5 );
+	}
+
+	template< typename Real >
+	void OctahedralNormalFactory< Real >::_Decode( const int16_t q[2] , VertexType &n )
+	{
+		double u = std::min< double >( std::max< double >( (double)q[0] / _Steps , -1. ) , 1. );
+		double v = std::min< double >( std::max< double >( (double)q[1] / _Steps , -1. ) , 1. );
+		double w = 1. - fabs(u) - fabs(v);
+		if( w<0 )
+		{
+			double _u = ( 1. - fabs(v) ) * ( u>=0 ? 1. : -1. );
+			double _v = ( 1. - fabs(u) ) * ( v>=0 ? 1. : -1. );
+			u = _u , v = _v;
+		}
+		double l = sqrt( u*u + v*v + w*w );
+		n[0] = (Real)( u/l ) , n[1] = (Real)( v/l ) , n[2] = (Real)( w/l );
+	}
+
+	template< typename Real >
+	void OctahedralNormalFactory< Real >::toBuffer( const VertexType &dt , Pointer( char ) buffer ) const
+	{
+		int16_t q[2];
+		_Encode( dt , q );
+		memcpy( buffer , q , sizeof(q) );
+	}
+
+	template< typename Real >
+	void OctahedralNormalFactory< Real >::fromBuffer( ConstPointer( char ) buffer , VertexType &dt ) const
+	{
+		int16_t q[2];
+		memcpy( q , buffer , sizeof(q) );
+		_Decode( q , dt );
+	}
+
+	template< typename Real >
+	bool OctahedralNormalFactory< Real >::readASCII( FILE *fp , VertexType &dt ) const
+	{
+		int _q[2];
+		if( fscanf( fp , " %d %d" , _q , _q+1 )!=2 ) return false;
+		int16_t q[] = { (int16_t)_q[0] , (int16_t)_q[1] };
+		_Decode( q , dt );
+		return true;
+	}
+
+	template< typename Real >
+	void OctahedralNormalFactory< Real >::writeASCII( FILE *fp , const VertexType &dt ) const
+	{
+		int16_t q[2];
+		_Encode( dt , q );
+		fprintf( fp , " %d %d" , (int)q[0] , (int)q[1] );
+	}
+
+	template< typename Real >
+	bool OctahedralNormalFactory< Real >::readBinary( FILE *fp , VertexType &dt ) const
+	{
+		int16_t q[2];
+		if( fread( q , sizeof(int16_t) , 2 , fp )!=2 ) return false;
+		_Decode( q , dt );
+		return true;
+	}
+
+	template< typename Real >
+	void OctahedralNormalFactory< Real >::writeBinary( FILE *fp , const VertexType &dt ) const
+	{
+		int16_t q[2];
+		_Encode( dt , q );
+		fwrite( q , sizeof(int16_t) , 2 , fp );
+	}
+
+	template< typename Real >
+	PlyProperty OctahedralNormalFactory< Real >::plyReadProperty( unsigned int idx ) const
+	{
+		if( idx>= plyReadNum() ) ERROR_OUT( "read property out of bounds" );
+		return PlyProperty( _PlyNames[idx] , PLY_SHORT , PLY_SHORT , (int)( sizeof(int16_t)*idx ) );
+	}
+	template< typename Real >
+	PlyProperty OctahedralNormalFactory< Real >::plyWriteProperty( unsigned int idx ) const
+	{
+		if( idx>=plyWriteNum() ) ERROR_OUT( "write property out of bounds" );
+		return PlyProperty( _PlyNames[idx] , PLY_SHORT , PLY_SHORT , (int)( sizeof(int16_t)*idx ) );
+	}
+
+	template< typename Real > const std::string OctahedralNormalFactory< Real >::_PlyNames[] = { "oct_nx" , "oct_ny" };
+
 	////////////////////
 	// TextureFactory //
 	////////////////////